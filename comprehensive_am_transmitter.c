@@ -19,12 +19,29 @@
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
 #include "hardware/interp.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/flash.h"
+#include "hardware/vreg.h"
 #include "pico/multicore.h"
 #include "ff.h"
 
+#if PICO_ON_DEVICE
+#include "hardware/structs/systick.h"
+#include "hardware/structs/ssi.h"
+#else
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 // Include PIO programs
 #include "am_carrier.pio.h"
 #include "advanced_am_carrier.pio.h"
+#include "sigma_delta_bitstream.pio.h"
+#include "parallel_dac.pio.h"
+#include "multiphase_carrier.pio.h"
+#include "fine_pwm.pio.h"
 
 // ============================================================================
 // CONFIGURATION AND TYPES
@@ -32,6 +49,9 @@
 
 // Hardware configuration
 #define RF_OUTPUT_PIN 21
+#define DAC_OUTPUT_BASE_PIN 6           // R-2R ladder LSB; up to 8 consecutive pins
+#define MULTIPHASE_OUTPUT_BASE_PIN 6    // Multi-phase carrier: P/N pin pair per phase
+#define MULTIPHASE_PHASES 3             // Phases spaced T/8: cancels the 3rd and 5th
 #define DUMMY_LOAD_LED_PIN 22
 #define STATUS_LED_PIN 25
 
@@ -40,6 +60,71 @@
 #define DEFAULT_SAMPLE_RATE 44100       // CD quality
 #define DEFAULT_MODULATION_DEPTH 80     // 80% modulation
 #define BUFFER_SIZE 2048
+#define PIPELINE_DEPTH 4                // Envelope blocks queued between cores (power of two)
+#define ENVELOPE_UNITY 4096             // Q12 envelope value of the unmodulated carrier
+#define CARRIER_HOLD_WORDS 256          // Unmodulated-carrier buffer replayed on underrun
+#define UNDERRUN_LOG_SIZE 16            // Most recent underrun timestamps kept
+#define SIGMA_DELTA_FULL_SCALE 4096     // 1-bit quantiser output, +-1.0 in Q12
+#define PIO_TIMING_LEVELS 64            // Duty levels of an am_carrier timing word
+#define PIO_SHAPED_MARGIN 6             // Levels kept clear at each end for the noise shaper
+#define CQAM_PILOT_HZ 25                // C-QUAM stereo pilot in the L-R channel
+#define CQAM_PILOT_DEPTH_PCT 4          // Pilot level, % of full modulation
+#define CORDIC_ITERATIONS 14            // atan2 to 1/65536 turn
+#define HILBERT_LENGTH 127              // SSB Hilbert FIR (every other tap is zero)
+#define MULTICARRIER_MAX 4              // Stations summed on the R-2R ladder, main included
+#define DPD_LUT_SHIFT 8                 // Pre-distortion table: a point every 256 envelope steps
+#define DPD_LUT_POINTS 33               // 0 .. 2x carrier, both ends included
+#define DPD_STEP_MS 100                 // Hold per level of the dpd-steps test signal
+#define FINE_PWM_MIN_OVERSAMPLING 12    // Fine PWM: a centred 50% pulse fits the program
+#define FINE_PWM_DECIMATION 32          // Self-test detector: sinc^3, carrier / 32 out
+
+// DSP load governor: per-block load is busy time / DMA block period
+#define GOVERNOR_OVERLOAD_PCT 90        // Load counted as overload at or above this
+#define GOVERNOR_RELAX_PCT 60           // Load counted as headroom below this
+#define GOVERNOR_STEP_DOWN_BLOCKS 4     // Consecutive overloaded blocks before degrading
+#define GOVERNOR_STEP_UP_BLOCKS 64      // Consecutive relaxed blocks before restoring
+#define GOVERNOR_MAX_HOLDOFF 4096       // Cap on the step-up wait after a bounce
+
+// Per-stage instrumentation: build with -DSTAGE_PROFILING=1. When off, every
+// probe compiles away.
+#ifndef STAGE_PROFILING
+#define STAGE_PROFILING 0
+#endif
+
+// Audio source settings
+#define XIP_AUDIO_FLASH_OFFSET (1024 * 1024)  // WAV image loaded with picotool at 0x10100000
+#define PERSIST_FLASH_BYTES (24 * 1024)       // Saved config and tables at the end of flash
+#define PERSIST_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - PERSIST_FLASH_BYTES)
+#define RAM_LOOP_MAX_BYTES (48 * 1024)        // Largest clip held by the RAM loop cache
+#define USB_STREAM_FIFO_SAMPLES 8192          // Host audio FIFO (power of two)
+#define USB_STREAM_STAMP_SHIFT 8              // One arrival timestamp per 256 samples
+#define USB_STREAM_MAX_ADJUST_PPM 10000       // Drift compensation range (+/-1%)
+#define XON  0x11                             // Flow control bytes sent to the host
+#define XOFF 0x13
+#define PLAYLIST_MAX_ENTRIES 64               // Tracks held from an M3U file or directory scan
+#define PLAYLIST_MAX_PATH 96
+#define PLAYLIST_PREFETCH_FRAMES (BUFFER_SIZE * 4)  // Open the next track this close to the end
+
+// Test signal generator
+#define TEST_SIGNAL_LEVEL 16384               // Peak level: -6 dBFS
+#define TEST_SINE_LUT_BITS 10                 // 1024-entry interpolated sine table
+#define TEST_SWEEP_START_HZ 20                // Log sweep start
+#define TEST_SWEEP_SECONDS 10                 // Log sweep period (repeats)
+#define PINK_NOISE_ROWS 8                     // Voss-McCartney generator rows
+
+// Clock planning (PLL VCO / post dividers and PIO divider per carrier)
+#define CLOCK_PLAN_XOSC_HZ 12000000           // Crystal feeding PLL_SYS
+#define CLOCK_PLAN_VCO_MIN_HZ 750000000
+#define CLOCK_PLAN_VCO_MAX_HZ 1600000000
+#define CLOCK_PLAN_SYS_MIN_HZ 100000000       // Keep enough DSP headroom
+#define CLOCK_PLAN_SYS_MAX_HZ 133000000       // Stock RP2040 rating
+#define CLOCK_PLAN_FRACTIONAL_PENALTY_MHZ 5000  // A fractional divider's spurs are worth 5 Hz of error
+
+// Overclock profiles and the DSP throughput self-test
+#define OVERCLOCK_VREG_SETTLE_MS 10           // Core voltage settles before clk_sys rises
+#define OVERCLOCK_FLASH_MAX_HZ 133000000      // QSPI flash SCK rating (clk_sys / boot2 divider)
+#define SELFTEST_WORDS 2048                   // RF words timed per self-test
+#define SELFTEST_WARMUP_WORDS 64              // Untimed: fill the XIP cache first
 
 // Melbourne AM stations for educational use
 typedef struct {
@@ -73,10 +158,18 @@ static const am_station_t melbourne_stations[] = {
 typedef enum {
     SIGNAL_MODE_SIMPLE,           // Basic high-quality (default)
     SIGNAL_MODE_SQUARE,           // Educational: basic square wave
-    SIGNAL_MODE_SIGMA_DELTA,      // Multi-bit sigma-delta
+    SIGNAL_MODE_SIGMA_DELTA,      // Packed 1-bit noise-shaped bitstream
     SIGNAL_MODE_SINE_WAVE,        // True sine wave generation
     SIGNAL_MODE_PREDISTORTION,    // Digital pre-distortion
-    SIGNAL_MODE_OVERSAMPLED       // Oversampled with filtering
+    SIGNAL_MODE_OVERSAMPLED,      // Oversampled with filtering
+    SIGNAL_MODE_PARALLEL_DAC,     // Multi-level samples on an external R-2R ladder
+    SIGNAL_MODE_MULTIPHASE,       // Harmonic-cancelling sum of phase-shifted squares
+    SIGNAL_MODE_CQAM,             // C-QUAM stereo: L+R envelope, L-R carrier phase
+    SIGNAL_MODE_DSB_SC,           // Double sideband, suppressed carrier
+    SIGNAL_MODE_USB,              // Upper sideband only (Hilbert quadrature)
+    SIGNAL_MODE_LSB,              // Lower sideband only
+    SIGNAL_MODE_MULTICARRIER,     // Several stations summed on the R-2R ladder
+    SIGNAL_MODE_FINE_PWM          // Noise-shaped pulse widths, one pulse per carrier cycle
 } signal_processing_mode_t;
 
 typedef enum {
@@ -88,6 +181,34 @@ typedef enum {
     FILTER_MODE_MULTIBAND         // Multiple band pass filters
 } filter_mode_t;
 
+// Audio input backends
+typedef enum {
+    AUDIO_SOURCE_SD,              // WAV file on SD card (default)
+    AUDIO_SOURCE_XIP_FLASH,       // WAV image in QSPI flash, read in place
+    AUDIO_SOURCE_RAM_LOOP,        // Short clip cached in RAM, looped forever
+    AUDIO_SOURCE_TEST_SIGNAL,     // Synthetic generator, no storage needed
+    AUDIO_SOURCE_USB_STREAM       // Raw PCM streamed from the USB host (stdin on host builds)
+} audio_source_type_t;
+
+// Synthetic test signals (--source test)
+typedef enum {
+    TEST_SIGNAL_TONE,             // Single tone at test_frequency
+    TEST_SIGNAL_TWO_TONE,         // IMD test: test_frequency + test_frequency2
+    TEST_SIGNAL_SWEEP,            // Logarithmic sweep, 20 Hz to 0.45 fs
+    TEST_SIGNAL_WHITE_NOISE,
+    TEST_SIGNAL_PINK_NOISE,
+    TEST_SIGNAL_SILENCE,
+    TEST_SIGNAL_DPD_STEPS         // Envelope staircase over the pre-distortion table points
+} test_signal_t;
+
+// Extra station in multi-carrier mode; the main one uses the configured
+// carrier, depth and audio source
+typedef struct {
+    uint32_t frequency;
+    uint8_t depth;                // Modulation depth, %
+    uint16_t tone_hz;             // Test tone it carries; 0 = plain carrier
+} station_config_t;
+
 // Configuration structure
 typedef struct {
     // Basic settings
@@ -95,12 +216,27 @@ typedef struct {
     uint32_t audio_sample_rate;
     uint8_t modulation_depth;
     char* wav_filename;
+    char* playlist;               // M3U file or directory; NULL = single file
+    audio_source_type_t audio_source;
+    
+    // Test signal generator
+    test_signal_t test_signal;
+    uint32_t test_frequency;
+    uint32_t test_frequency2;
+    uint32_t test_seed;
     
     // Advanced signal processing
     signal_processing_mode_t signal_mode;
     filter_mode_t filter_mode;
     uint8_t oversampling_rate;
     bool enable_predistortion;
+    bool enable_governor;         // Trade filter/predistortion quality for real time
+    uint8_t overclock_profile;    // Index into overclock_profiles
+    uint8_t sigma_delta_order;    // 2 or 3: noise-shaping order of bitstream/DAC
+    uint8_t dac_bits;             // 4, 6 or 8 R-2R ladder pins
+    bool noise_shaping;           // Dither and noise-shape the timing words
+    station_config_t stations[MULTICARRIER_MAX - 1];
+    uint8_t station_count;        // Extra stations in multi-carrier mode
     
     // Educational features
     bool educational_mode;
@@ -138,6 +274,258 @@ typedef struct {
     uint32_t data_size;
 } wav_header_t;
 
+// WAV audio_format codes understood by the transmitter
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_IMA_ADPCM    0x0011  // 4:1 compressed, decoded on core 0
+#define ADPCM_MAX_BLOCK_ALIGN   2048    // Decoded block must fit the file buffer
+
+// IMA-ADPCM per-channel decoder state
+typedef struct {
+    int32_t predictor;
+    int32_t step_index;
+} ima_adpcm_state_t;
+
+// Linear-interpolation sample rate converter (mono, fixed point)
+typedef struct {
+    uint32_t step;                // Input samples per output sample, Q16.16
+    uint32_t position;            // Read position relative to history sample, Q16.16
+    int16_t history;              // Last input sample of the previous block
+} audio_resampler_t;
+
+// Audio source interface: backends deliver interleaved 16-bit frames in
+// blocks. read_block returns a pointer to the frames (which may point
+// straight into flash or a RAM cache) and 0 frames at end of stream.
+typedef struct audio_source audio_source_t;
+
+typedef struct {
+    const char* name;
+    bool (*open)(audio_source_t* src, const char* location);
+    const int16_t* (*read_block)(audio_source_t* src, uint32_t max_frames, uint32_t* frames);
+    bool (*rewind)(audio_source_t* src);
+    void (*close)(audio_source_t* src);
+} audio_source_ops_t;
+
+// Per-source throughput counters
+typedef struct {
+    uint64_t bytes_read;          // Bytes pulled from the backing store
+    uint64_t frames_delivered;
+    uint32_t blocks_delivered;
+    uint64_t busy_us;             // Time spent inside read_block
+    uint32_t max_block_us;
+    uint32_t rewinds;
+} audio_source_stats_t;
+
+struct audio_source {
+    const audio_source_ops_t* ops;
+    audio_source_type_t type;
+    bool is_open;
+    
+    // Stream format
+    uint32_t sample_rate;
+    uint16_t num_channels;
+    uint32_t total_frames;        // 0 = endless (loops, generators)
+    
+    audio_source_stats_t stats;
+    
+    // Backend state
+    union {
+        struct {
+            FIL file;
+            wav_header_t header;
+            FSIZE_t data_start;
+            uint32_t data_remaining;
+            uint32_t decoded_frames;  // ADPCM frames held in pcm[]
+            uint32_t decoded_pos;
+            uint8_t adpcm_block[ADPCM_MAX_BLOCK_ALIGN];
+            int16_t pcm[BUFFER_SIZE * 2];
+        } sd;
+        struct {
+            const int16_t* data;
+            uint32_t position;        // In frames
+        } xip;
+        struct {
+            uint32_t length;          // In frames
+            uint32_t position;
+        } ram;
+        struct {
+            uint32_t phase[2];
+            uint32_t phase_increment[2];
+            uint32_t sweep_start_increment;
+            uint32_t sweep_ratio_q30;     // Per-sample increment growth, Q2.30
+            uint32_t sweep_length;        // Samples per sweep
+            uint32_t sweep_position;
+            uint32_t noise_state;         // xorshift32
+            uint32_t pink_counter;
+            int32_t pink_rows[PINK_NOISE_ROWS];
+            int32_t pink_sum;
+            int16_t pcm[BUFFER_SIZE];
+        } test;
+        struct {
+            audio_resampler_t resampler;  // Adaptive: step trimmed from FIFO fill
+            int32_t fill_integral;
+            int32_t adjust_ppm;
+            bool xoff_sent;
+            uint32_t underruns;
+            uint32_t xoff_count;
+            uint64_t latency_total_us;
+            uint32_t latency_count;
+            uint32_t latency_min_us;
+            uint32_t latency_max_us;
+            int16_t input[BUFFER_SIZE + BUFFER_SIZE / 64 + 2];
+            int16_t pcm[BUFFER_SIZE + 1];
+        } usb;
+    } u;
+};
+
+// Block handed from core 0 (audio rate) to core 1 (RF rate)
+typedef struct {
+    uint16_t envelope[BUFFER_SIZE];  // Carrier amplitude, Q12 (ENVELOPE_UNITY = 1.0)
+    union {
+        int16_t phase[BUFFER_SIZE];      // C-QUAM carrier phase, 65536 = one turn
+        int16_t quadrature[BUFFER_SIZE]; // SSB: Hilbert transform of the audio, Q12
+        uint16_t station_envelope[MULTICARRIER_MAX - 1][BUFFER_SIZE];  // Extra stations, Q12
+    };
+    uint32_t count;
+} pipeline_block_t;
+
+// Wake-to-work latency: time from an event being signalled (DMA IRQ,
+// block published, slot freed) to the waiting core resuming work
+#define WAKE_HISTOGRAM_BINS 16          // log2(us) buckets: 0, 1, 2-3, 4-7, ...
+
+typedef enum {
+    WAKE_CORE0_SLOT_FREE,         // Core 0 waiting for a free pipeline block
+    WAKE_CORE1_BLOCK_READY,       // Core 1 waiting for an envelope block
+    WAKE_CORE1_DMA_DONE,          // Core 1 waiting for a free DMA buffer
+    WAKE_EVENT_COUNT
+} wake_event_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t bins[WAKE_HISTOGRAM_BINS];
+} wake_latency_t;
+
+// Telemetry log: fixed-size binary records pushed by any core (or IRQ) and
+// formatted by core 0, so the RF-rate core never blocks in printf
+#define TELEMETRY_RING_SIZE 64          // Records per producer core (power of two)
+
+typedef enum {
+    LOG_CORE1_START,              // (none)
+    LOG_CORE1_STOP,               // (none)
+    LOG_STATUS,                   // elapsed s, samples processed, underruns
+    LOG_TIME_LIMIT,               // limit s
+    LOG_UNDERRUN,                 // underrun count, DMA buffer that starved
+    LOG_STAGE_PROFILE,            // (core 1 stages in stage_profile_snapshot)
+    LOG_GOVERNOR,                 // old rung, new rung, load %
+    LOG_RETUNE,                   // old carrier Hz, new carrier Hz, PIO divider (16.8)
+    LOG_FIRST_RF,                 // us since boot
+} log_event_t;
+
+typedef struct {
+    uint32_t timestamp_us;        // time_us_32 at push
+    uint16_t event;               // log_event_t
+    uint16_t core;
+    uint32_t args[3];
+} log_record_t;
+
+typedef struct {
+    log_record_t records[TELEMETRY_RING_SIZE];
+    volatile uint32_t head;       // Written by the producing core only
+    volatile uint32_t tail;       // Written by core 0 only
+    volatile uint32_t dropped;    // Records lost to a full ring
+} telemetry_ring_t;
+
+// Per-stage cost, measured per block: SysTick cycles on the device,
+// nanoseconds in the host build
+#define STAGE_HISTOGRAM_BINS 25         // log2 buckets up to the 24-bit SysTick range
+
+typedef enum {
+    STAGE_DECODE,                 // Core 0: audio_source_read
+    STAGE_RESAMPLE,               // Core 0: resampler_process
+    STAGE_MODULATE,               // Core 1: generate_am_signal
+    STAGE_FILTER,                 // Core 1: bandpass IIR
+    STAGE_PIO_FORMAT,             // Core 1: shaped_pio_timing / convert_to_pio_timing
+    STAGE_DMA_QUEUE,              // Core 1: hand-off to the DMA engine
+    STAGE_COUNT
+} profile_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t bins[STAGE_HISTOGRAM_BINS];
+} stage_stats_t;
+
+// clk_sys and PIO divider chosen for a carrier
+typedef struct {
+    uint32_t vco_hz;
+    uint8_t postdiv1;
+    uint8_t postdiv2;
+    uint32_t sys_hz;
+    uint16_t div_int;             // PIO divider, integer part
+    uint8_t div_frac;             // PIO divider, 1/256ths (0 = no fractional jitter)
+    uint32_t error_mhz;           // |actual - requested| carrier, millihertz
+    uint8_t vreg_voltage;         // enum vreg_voltage the profile runs sys_hz at
+} clock_plan_t;
+
+// clk_sys band and core voltage of an overclock profile
+typedef struct {
+    const char* name;
+    uint32_t min_sys_hz;
+    uint32_t max_sys_hz;
+    uint8_t vreg_voltage;         // enum vreg_voltage
+} overclock_profile_t;
+
+// Named settings snapshot kept by the serial shell (and persisted to flash)
+#define SHELL_PROFILE_SLOTS 8
+#define SHELL_PROFILE_NAME 16
+
+typedef struct {
+    char name[SHELL_PROFILE_NAME];  // Empty = free slot
+    transmitter_config_t config;  // String pointers are re-pointed on load
+    char wav_filename[PLAYLIST_MAX_PATH];
+    char playlist[PLAYLIST_MAX_PATH];
+} shell_profile_t;
+
+// Pre-distortion flavours, most to least expensive
+typedef enum {
+    PREDISTORT_OFF,
+    PREDISTORT_LUT                // Piecewise-linear gain/phase table
+} predistortion_level_t;
+
+// Pre-distortion correction at DPD_LUT_POINTS wanted envelope levels,
+// interpolated in between. Written by dpd_fit.py from a PA model or a
+// capture of the dpd-steps test signal.
+typedef struct {
+    int16_t gain[DPD_LUT_POINTS];   // Q12 drive / wanted envelope
+    int16_t phase[DPD_LUT_POINTS];  // 1/65536 turns added to the carrier phase
+} dpd_table_t;
+
+// One rung of the quality ladder walked by the load governor
+typedef struct {
+    const char* name;
+    uint8_t max_iir_sections;     // Cap on cascaded biquads
+    uint8_t fir_tap_shift;        // FIR length >> shift (8 = bypass)
+    predistortion_level_t predistortion;
+} quality_rung_t;
+
+// 1-bit sigma-delta loop state (error-feedback form)
+typedef struct {
+    uint32_t phase;               // Carrier NCO, 2 * oversampling bits per cycle
+    int32_t error[3];             // Quantisation error e[n-1], e[n-2], e[n-3]
+    int32_t shaped[3];            // Noise-shaping filter output history
+} sigma_delta_state_t;
+
+// Timing-word requantiser: TPDF dither plus second-order error feedback
+// with its zeros at the NCO frequency, where the carrier and its sidebands sit
+typedef struct {
+    int32_t error[2];             // Requantisation error e[n-1], e[n-2], 12-bit units
+    int32_t feedback;             // 2 cos(NCO step per word), Q14
+    uint32_t dither;              // xorshift32 state
+} requantiser_state_t;
+
 // Biquad filter section
 typedef struct {
     float b[3];  // Numerator coefficients
@@ -156,10 +544,21 @@ static transmitter_config_t config = {
     .audio_sample_rate = DEFAULT_SAMPLE_RATE,
     .modulation_depth = DEFAULT_MODULATION_DEPTH,
     .wav_filename = "audio.wav",
+    .playlist = NULL,
+    .audio_source = AUDIO_SOURCE_SD,
+    .test_signal = TEST_SIGNAL_TONE,
+    .test_frequency = 1000,
+    .test_frequency2 = 1900,
+    .test_seed = 1,
     .signal_mode = SIGNAL_MODE_SIMPLE,
     .filter_mode = FILTER_MODE_NONE,
     .oversampling_rate = 8,
     .enable_predistortion = false,
+    .enable_governor = true,
+    .overclock_profile = 0,
+    .sigma_delta_order = 2,
+    .dac_bits = 8,
+    .noise_shaping = true,
     .educational_mode = true,
     .verbose_analysis = false,
     .spectrum_analysis = false,
@@ -174,36 +573,272 @@ static transmitter_config_t config = {
     .filter_stopband_db = 60
 };
 
-// Audio buffers
-static int16_t audio_buffer_a[BUFFER_SIZE];
-static int16_t audio_buffer_b[BUFFER_SIZE];
-static uint32_t modulation_buffer_a[BUFFER_SIZE];
-static uint32_t modulation_buffer_b[BUFFER_SIZE];
-static volatile bool buffer_a_ready = false;
-static volatile bool buffer_b_ready = false;
-static volatile bool use_buffer_a = true;
+// Inter-core pipeline: single-producer (core 0) / single-consumer (core 1)
+// ring of envelope blocks. Each index is written by one core only.
+static pipeline_block_t pipeline_blocks[PIPELINE_DEPTH];
+static volatile uint32_t pipeline_head = 0;   // Next block core 0 fills
+static volatile uint32_t pipeline_tail = 0;   // Next block core 1 consumes
 static volatile bool transmission_active = false;
 
+// Core 1 -> PIO: two DMA-fed buffers of formatted PIO words. Core 1 fills
+// one while the DMA channel drains the other; the completion IRQ chains
+// straight to the next full buffer.
+static uint32_t modulation_buffers[2][BUFFER_SIZE];
+static volatile bool modulation_buffer_full[2] = {false, false};
+static volatile int dma_active_buffer = -1;   // -1 = DMA idle
+static int dma_last_buffer = 1;               // Last real buffer played; 0 comes next
+
+// Underrun fallback: when core 1 misses a deadline the DMA replays this
+// buffer, so the carrier keeps running unmodulated instead of stopping
+#define DMA_CARRIER_HOLD 2                    // dma_active_buffer value while holding
+static uint32_t carrier_hold_buffer[CARRIER_HOLD_WORDS];
+static uint32_t carrier_hold_words = CARRIER_HOLD_WORDS;  // Whole carrier cycles
+static volatile bool output_primed = false;   // First real buffer has been queued
+static volatile uint32_t underrun_count = 0;  // Starvation events
+static volatile uint32_t hold_blocks_played = 0;
+static volatile uint64_t underrun_log[UNDERRUN_LOG_SIZE];  // time_us_64 of each event
+
+// PIO divider (16.8) to load when a buffer starts playing; 0 = unchanged
+static volatile uint32_t buffer_pio_divider[2] = {0, 0};
+
+// Boot-to-first-RF time (time_us_64 when the carrier first started)
+static uint64_t first_rf_us = 0;
+
+// Event timestamps (time_us_32) for wake-latency measurement
+static volatile uint32_t wake_signal_time[WAKE_EVENT_COUNT];
+static wake_latency_t wake_latency[WAKE_EVENT_COUNT];
+
+// Serial shell profiles
+static shell_profile_t shell_profiles[SHELL_PROFILE_SLOTS];
+
+// One SPSC telemetry ring per producing core; core 0 drains both
+static telemetry_ring_t telemetry_rings[2];
+static volatile bool core1_stopped = false;
+
+#if STAGE_PROFILING
+// Each stage is written by the one core that runs it; core 1 copies its
+// stages to the snapshot before asking core 0 to print them
+static stage_stats_t stage_stats[STAGE_COUNT];
+static stage_stats_t stage_profile_snapshot[STAGE_COUNT];
+static volatile bool stage_profile_requested = false;
+void report_stage_profile(const stage_stats_t* core1_stats);
+#endif
+
+// Per-core utilisation (time spent waiting on the other stage)
+static volatile uint64_t core_wait_us[2] = {0, 0};
+static uint64_t pipeline_start_us = 0;
+
 // Signal processing
 static uint32_t waveform_lut[4096];
 static uint32_t phase_accumulator = 0;
+
+// Packed sigma-delta bitstream: NTF taps in Q12, loop state owned by core 1
+static sigma_delta_state_t sigma_delta;
+static int32_t sigma_delta_error_taps[3];     // NTF numerator minus denominator
+static int32_t sigma_delta_feedback_taps[3];  // NTF denominator (3rd order only)
+static uint32_t sigma_delta_phase_step;
 static uint32_t phase_increment;
-static biquad_section_t filter_sections[4];
-static float fir_coefficients[256];
+
+// Timing-word requantiser, owned by core 1
+static requantiser_state_t requantiser = {.dither = 1};  // xorshift needs != 0
+
+// Coefficient banks are double-buffered for runtime retuning: core 0
+// designs into the idle bank and core 1 swaps at a block boundary
+#define FIR_BANK_TAPS (256 + 128 + 64)  // Full, half and quarter kernels
+static biquad_section_t filter_banks[2][4];
+static float fir_banks[2][FIR_BANK_TAPS];
+static uint32_t active_bank = 0;
+static biquad_section_t* filter_sections = filter_banks[0];
+static float* fir_coefficients = fir_banks[0];
 static uint8_t num_filter_sections = 0;
 static uint8_t fir_length = 0;
 
+// Governor-controlled processing cost. Filter settings are only touched by
+// core 1; the pre-distortion level is read by core 0.
+static const quality_rung_t quality_ladder[] = {
+    {"full",           4, 0, PREDISTORT_LUT},
+    {"reduced filter", 2, 1, PREDISTORT_LUT},
+    {"minimal filter", 1, 2, PREDISTORT_LUT},
+    {"unfiltered",     0, 8, PREDISTORT_OFF},
+};
+#define QUALITY_RUNGS (sizeof(quality_ladder) / sizeof(quality_ladder[0]))
+
+static const float* active_fir_coefficients = fir_banks[0];
+static uint8_t active_fir_length = 0;
+static uint8_t active_iir_sections = 0;
+static volatile predistortion_level_t active_predistortion = PREDISTORT_LUT;
+
+// Pre-distortion table in use, and one requested with --dpd-table for the
+// next start ("default" = the built-in curve)
+static dpd_table_t dpd_table;
+static char dpd_table_request[PLAYLIST_MAX_PATH];
+static bool dpd_table_fitted = false;  // Loaded from a file, not the built-in curve
+
+// Load measurement: DMA time for one full buffer, core 0 busy time per block
+static volatile uint32_t dma_block_us = 0;
+static volatile uint32_t dma_start_us = 0;
+static volatile uint32_t core0_block_busy_us = 0;
+
 // PIO and DMA
 static PIO pio;
 static uint sm;
 static uint dma_chan;
 
+// Multi-phase carrier: the leading phases' state machines and DMA channels
+// (sm and dma_chan drive the last phase), and the half-cycle word for each
+// envelope >> 5
+static uint lead_sms[MULTIPHASE_PHASES - 1];
+static uint lead_dma_chans[MULTIPHASE_PHASES - 1];
+static uint lead_dma_count = 0;             // Claimed by setup_modulation_dma()
+static uint32_t multiphase_words[257];
+
+// C-QUAM: the carrier period in PIO cycles, its high count per
+// envelope >> 5, and the 25 Hz pilot oscillator (core 0)
+typedef struct {
+    int16_t phase;                // Last carrier phase applied
+    int16_t high;                 // Last high count, for centring the pulse
+    int32_t edge_error;           // Edge time owed to the next word, Q16 cycles
+    int32_t edge_error_sum;       // Its running sum, for first-order shaping
+} cqam_state_t;
+
+static uint32_t cqam_period;
+static uint16_t cqam_high_counts[257];
+static cqam_state_t cqam;
+static uint32_t cqam_pilot_phase = 0;
+static uint32_t cqam_pilot_step = 0;
+
+// Fine PWM: the carrier period in PIO cycles, the pulse width per
+// amplitude >> 7 (Q8 cycles) and the fundamental of each whole width (Q15)
+typedef struct {
+    int32_t error[2];             // Width error e[n-1], e[n-2], Q15 amplitude
+    uint32_t parity;              // Odd widths alternate their spare cycle
+} fine_pwm_state_t;
+
+static uint32_t fine_pwm_period;
+static uint16_t fine_pwm_widths[257];
+static int32_t fine_pwm_levels[33];       // Widths 0 .. oversampling (at most 32)
+static fine_pwm_state_t fine_pwm;
+
+// SSB Hilbert transformer (core 0). Only taps an odd distance from the
+// centre are non-zero and they are antisymmetric, so one Q15 coefficient
+// per pair; the history is stored twice so the window never wraps.
+typedef struct {
+    int16_t history[2 * HILBERT_LENGTH];
+    uint32_t position;
+} hilbert_state_t;
+
+static int16_t hilbert_taps[(HILBERT_LENGTH + 1) / 4];
+static hilbert_state_t hilbert;
+
+// Multi-carrier: one NCO per station at the ladder's sample rate, and a
+// first-order requantiser shared by the sum (core 1); the extra stations'
+// test tones (core 0)
+typedef struct {
+    uint32_t phase[MULTICARRIER_MAX];
+    int32_t error;                // Last quantisation error, Q12 like the sum
+} multicarrier_state_t;
+
+static multicarrier_state_t multicarrier;
+static uint32_t multicarrier_steps[MULTICARRIER_MAX];
+static int32_t multicarrier_gain;             // Q12: 1 / stations
+static uint32_t multicarrier_count = 1;
+static uint32_t station_tone_phase[MULTICARRIER_MAX - 1];
+static uint32_t station_tone_step[MULTICARRIER_MAX - 1];
+
 // Educational analysis
 static float measured_thd = 0.0f;
 static float harmonic_levels[10];
 static uint32_t samples_processed = 0;
 static uint32_t transmission_start_time = 0;
 
+// Compressed audio decode statistics (core 0)
+static uint64_t adpcm_decode_time_us = 0;
+static uint32_t adpcm_frames_decoded = 0;
+static uint32_t adpcm_blocks_decoded = 0;
+
+// ============================================================================
+// CLOCK PLANNING
+// ============================================================================
+//
+// The PIO runs at carrier * oversampling * 2. Rather than dividing whatever
+// clk_sys happens to be, search every PLL_SYS setting (12 MHz x FBDIV,
+// VCO 750-1600 MHz, post dividers 1-7) in the allowed clk_sys range for the
+// one that reaches the carrier exactly, ideally with an integer PIO
+// divider: the fractional divider dithers the period and puts spurs around
+// the carrier. Pure integer arithmetic, no hardware access.
+//
+// Overclock profiles widen the band upwards: each pairs a clk_sys ceiling
+// with the core voltage it needs, since the PIO can toggle no faster than
+// clk_sys and carrier * oversampling * 2 outgrows the stock clock above a
+// few MHz.
+
+static const overclock_profile_t overclock_profiles[] = {
+    {"stock", CLOCK_PLAN_SYS_MIN_HZ, CLOCK_PLAN_SYS_MAX_HZ, VREG_VOLTAGE_1_10},
+    {"200",   CLOCK_PLAN_SYS_MAX_HZ, 200000000,             VREG_VOLTAGE_1_15},
+    {"250",   200000000,             250000000,             VREG_VOLTAGE_1_20},
+    {"300",   250000000,             300000000,             VREG_VOLTAGE_1_30},
+};
+
+#define NUM_OVERCLOCK_PROFILES (sizeof(overclock_profiles) / sizeof(overclock_profiles[0]))
+
+// Carrier produced by a given clk_sys and 16.8 PIO divider, in millihertz
+static uint64_t clock_plan_carrier_mhz(uint32_t sys_hz, uint32_t div256, uint32_t oversampling) {
+    uint64_t denominator = (uint64_t)div256 * oversampling * 2;
+    return ((uint64_t)sys_hz * 256 * 1000 + denominator / 2) / denominator;
+}
+
+bool plan_carrier_clock(uint32_t carrier_hz, uint32_t oversampling,
+                        uint32_t min_sys_hz, uint32_t max_sys_hz, clock_plan_t* plan) {
+    uint64_t best_score = UINT64_MAX;
+    uint64_t pio_hz = (uint64_t)carrier_hz * oversampling * 2;
+    if (pio_hz == 0) return false;
+    
+    for (uint32_t fbdiv = 16; fbdiv <= 320; fbdiv++) {
+        uint32_t vco = CLOCK_PLAN_XOSC_HZ * fbdiv;
+        if (vco < CLOCK_PLAN_VCO_MIN_HZ || vco > CLOCK_PLAN_VCO_MAX_HZ) continue;
+        
+        for (uint32_t pd1 = 1; pd1 <= 7; pd1++) {
+            for (uint32_t pd2 = 1; pd2 <= pd1; pd2++) {
+                if (vco % (pd1 * pd2) != 0) continue;  // clk_sys must be whole Hz
+                uint32_t sys = vco / (pd1 * pd2);
+                if (sys < min_sys_hz || sys > max_sys_hz) continue;
+                
+                uint64_t div256 = ((uint64_t)sys * 256 + pio_hz / 2) / pio_hz;
+                if (div256 < 256 || div256 > 0xFFFFFF) continue;  // 1.0 .. 65535.996
+                
+                uint64_t actual = clock_plan_carrier_mhz(sys, div256, oversampling);
+                uint64_t target = (uint64_t)carrier_hz * 1000;
+                uint64_t error = actual > target ? actual - target : target - actual;
+                uint64_t score = error + ((div256 & 0xFF) ? CLOCK_PLAN_FRACTIONAL_PENALTY_MHZ : 0);
+                
+                // Ties go to the faster clock: more DSP headroom
+                if (score < best_score || (score == best_score && sys > plan->sys_hz)) {
+                    best_score = score;
+                    plan->vco_hz = vco;
+                    plan->postdiv1 = pd1;
+                    plan->postdiv2 = pd2;
+                    plan->sys_hz = sys;
+                    plan->div_int = div256 >> 8;
+                    plan->div_frac = div256 & 0xFF;
+                    plan->error_mhz = error > UINT32_MAX ? UINT32_MAX : error;
+                }
+            }
+        }
+    }
+    return best_score != UINT64_MAX;
+}
+
+// Plan within a profile's band and record the voltage it runs at
+static bool plan_profile_clock(uint32_t carrier_hz, uint32_t oversampling,
+                               const overclock_profile_t* profile, clock_plan_t* plan) {
+    if (!plan_carrier_clock(carrier_hz, oversampling, profile->min_sys_hz,
+                            profile->max_sys_hz, plan)) {
+        return false;
+    }
+    plan->vreg_voltage = profile->vreg_voltage;
+    return true;
+}
+
 // ============================================================================
 // COMMAND LINE PARSING
 // ============================================================================
@@ -235,13 +870,60 @@ static void print_usage(const char* program_name) {
     printf("  -m, --mode MODE         Signal mode:\n");
     printf("                          simple    = High quality (default)\n");
     printf("                          square    = Basic square wave\n");
-    printf("                          sigma     = Sigma-delta modulation\n");
+    printf("                          sigma     = 1-bit sigma-delta bitstream\n");
     printf("                          sine      = Pure sine wave\n");
     printf("                          predist   = Digital pre-distortion\n");
     printf("                          oversample= Oversampled + filtered\n");
+    printf("                          dac       = R-2R ladder on GPIO %d+ (see --dac-bits)\n",
+           DAC_OUTPUT_BASE_PIN);
+    printf("                          multiphase= %d phased squares on GPIO %d-%d\n",
+           MULTIPHASE_PHASES, MULTIPHASE_OUTPUT_BASE_PIN,
+           MULTIPHASE_OUTPUT_BASE_PIN + 2 * MULTIPHASE_PHASES - 1);
+    printf("                          cquam     = C-QUAM stereo (phase-modulated carrier)\n");
+    printf("                          dsb       = Double sideband, suppressed carrier\n");
+    printf("                          usb / lsb = Single sideband (half the bandwidth)\n");
+    printf("                          multi     = Main + --stations summed on the R-2R ladder\n");
+    printf("                          finepwm   = Noise-shaped pulse width (oversample >= %d)\n",
+           FINE_PWM_MIN_OVERSAMPLING);
     printf("  -d, --depth PERCENT     Modulation depth 0-100%% (default: 80)\n");
     printf("  --oversample RATE       Oversampling rate (default: 8)\n");
-    printf("  --predistortion         Enable digital pre-distortion\n\n");
+    printf("  --sd-order N            Sigma-delta noise shaping order, 2 or 3 (default: 2)\n");
+    printf("  --dac-bits N            R-2R ladder width, 4, 6 or 8 pins (default: 8)\n");
+    printf("  --stations LIST         Up to %d extra stations for multi mode, comma separated:\n"
+           "                          HZ|CALLSIGN[:DEPTH[:TONE_HZ]], or 'none'\n",
+           MULTICARRIER_MAX - 1);
+    printf("  --no-noise-shaping      Plain rounding to the %d timing levels instead of\n"
+           "                          dither and noise shaping\n", PIO_TIMING_LEVELS);
+    printf("  --predistortion         Enable digital pre-distortion\n");
+    printf("  --dpd-table FILE        Pre-distortion table from dpd_fit.py on the SD card,\n"
+           "                          or 'default' (implies --predistortion)\n\n");
+    
+    printf("Audio Source:\n");
+    printf("  --source TYPE           Where audio comes from:\n");
+    printf("                          sd        = WAV file on SD card (default)\n");
+#if PICO_ON_DEVICE
+    printf("                          xip       = WAV image in flash at 0x%08X\n",
+           XIP_BASE + XIP_AUDIO_FLASH_OFFSET);
+#endif
+    printf("                          ram       = WAV clip cached in RAM and looped\n");
+    printf("                          test      = Built-in test signal generator\n");
+    printf("                          usb       = Raw s16le mono PCM from the USB host\n");
+    printf("  --playlist PATH         Play an M3U file or every WAV in a directory,\n");
+    printf("                          gaplessly and repeating (implies --source sd)\n");
+    printf("  --test-signal TYPE      Test signal (implies --source test):\n");
+    printf("                          tone      = Single tone (default)\n");
+    printf("                          imd       = Two-tone intermodulation test\n");
+    printf("                          sweep     = %d s log sweep from %d Hz\n",
+           TEST_SWEEP_SECONDS, TEST_SWEEP_START_HZ);
+    printf("                          white     = White noise\n");
+    printf("                          pink      = Pink noise\n");
+    printf("                          silence   = Digital silence (carrier only)\n");
+    printf("                          dpd-steps = Envelope staircase for pre-distortion\n"
+           "                                      capture, %d ms per level (use --depth 100)\n",
+           DPD_STEP_MS);
+    printf("  --test-freq HZ          Tone frequency (default: 1000)\n");
+    printf("  --test-freq2 HZ         Second IMD tone (default: 1900)\n");
+    printf("  --seed N                Noise generator seed (default: 1)\n\n");
     
     printf("Filtering:\n");
     printf("  --filter TYPE           Filter type:\n");
@@ -252,7 +934,15 @@ static void print_usage(const char* program_name) {
     printf("                          bp-ellip  = Elliptic bandpass\n");
     printf("                          multiband = Multiple bandpass filters\n");
     printf("  --bandwidth HZ          Filter bandwidth in Hz (default: 20000)\n");
-    printf("  --order N               Filter order (default: 6)\n\n");
+    printf("  --order N               Filter order (default: 6)\n");
+    printf("  --plan-stations         Show the clock plan for every station\n");
+    printf("  --overclock PROFILE     clk_sys band and core voltage:\n");
+    printf("                          stock = 100-133 MHz at 1.10 V (default)\n");
+    printf("                          200   = 133-200 MHz at 1.15 V\n");
+    printf("                          250   = 200-250 MHz at 1.20 V\n");
+    printf("                          300   = 250-300 MHz at 1.30 V\n");
+    printf("  --no-governor           Keep full filter/pre-distortion quality even\n");
+    printf("                          when the DSP cannot keep up\n\n");
     
     printf("Educational Features:\n");
     printf("  --best-quality          Enable ALL advanced features (max quality)\n");
@@ -292,6 +982,31 @@ static void list_melbourne_stations() {
     printf("\nUsage: --station 3AW  or  --station 3LO  etc.\n");
 }
 
+// Planner results for every station at the configured oversampling and profile
+static void list_clock_plans(const transmitter_config_t* cfg) {
+    const overclock_profile_t* profile = &overclock_profiles[cfg->overclock_profile];
+    uint32_t oversampling = cfg->oversampling_rate;
+    printf("Clock plans (%dx oversampling, profile %s, clk_sys %d-%d MHz):\n", oversampling,
+           profile->name, profile->min_sys_hz / 1000000, profile->max_sys_hz / 1000000);
+    printf("Callsign | Freq (kHz) | clk_sys (MHz) | VCO/PD1/PD2   | PIO div    | Error (Hz)\n");
+    printf("---------|------------|---------------|---------------|------------|-----------\n");
+    
+    for (int i = 0; i < NUM_MELBOURNE_STATIONS; i++) {
+        clock_plan_t plan = {0};
+        if (!plan_profile_clock(melbourne_stations[i].frequency, oversampling,
+                                profile, &plan)) {
+            printf("%-8s | %8.1f | no plan\n", melbourne_stations[i].callsign,
+                   melbourne_stations[i].frequency / 1000.0f);
+            continue;
+        }
+        printf("%-8s | %8.1f | %13.3f | %4d/%d/%d      | %5d+%3d/256 | %.3f%s\n",
+               melbourne_stations[i].callsign, melbourne_stations[i].frequency / 1000.0f,
+               plan.sys_hz / 1e6f, plan.vco_hz / 1000000, plan.postdiv1, plan.postdiv2,
+               plan.div_int, plan.div_frac, plan.error_mhz / 1000.0f,
+               plan.div_frac ? "" : " (integer)");
+    }
+}
+
 static uint32_t find_station_frequency(const char* callsign) {
     for (int i = 0; i < NUM_MELBOURNE_STATIONS; i++) {
         if (strcasecmp(callsign, melbourne_stations[i].callsign) == 0) {
@@ -301,7 +1016,9 @@ static uint32_t find_station_frequency(const char* callsign) {
     return 0;  // Not found
 }
 
-static int parse_command_line(int argc, char* argv[]) {
+// Apply option-style arguments to a configuration. Shared by the command
+// line and the serial shell; returns 1 for help/info, -1 on error.
+static int parse_options(transmitter_config_t* cfg, int argc, char* argv[]) {
     static struct option long_options[] = {
         {"frequency",       required_argument, 0, 'f'},
         {"station",         required_argument, 0, 's'},
@@ -324,6 +1041,20 @@ static int parse_command_line(int argc, char* argv[]) {
         {"time-limit",      required_argument, 0, 1011},
         {"best-quality",    no_argument,       0, 1012},
         {"max-quality",     no_argument,       0, 1012}, // Alias for best-quality
+        {"source",          required_argument, 0, 1013},
+        {"test-signal",     required_argument, 0, 1014},
+        {"test-freq",       required_argument, 0, 1015},
+        {"test-freq2",      required_argument, 0, 1016},
+        {"seed",            required_argument, 0, 1017},
+        {"playlist",        required_argument, 0, 1018},
+        {"no-governor",     no_argument,       0, 1019},
+        {"plan-stations",   no_argument,       0, 1020},
+        {"overclock",       required_argument, 0, 1021},
+        {"sd-order",        required_argument, 0, 1022},
+        {"dac-bits",        required_argument, 0, 1023},
+        {"stations",        required_argument, 0, 1024},
+        {"dpd-table",       required_argument, 0, 1025},
+        {"no-noise-shaping", no_argument,      0, 1026},
         {0, 0, 0, 0}
     };
     
@@ -333,8 +1064,8 @@ static int parse_command_line(int argc, char* argv[]) {
     while ((c = getopt_long(argc, argv, "f:s:m:d:evh", long_options, &option_index)) != -1) {
         switch (c) {
             case 'f':
-                config.carrier_frequency = atoi(optarg);
-                if (config.carrier_frequency < 10000 || config.carrier_frequency > 30000000) {
+                cfg->carrier_frequency = atoi(optarg);
+                if (cfg->carrier_frequency < 10000 || cfg->carrier_frequency > 30000000) {
                     printf("Error: Invalid frequency %s (10kHz - 30MHz supported)\n", optarg);
                     return -1;
                 }
@@ -346,24 +1077,40 @@ static int parse_command_line(int argc, char* argv[]) {
                     printf("Error: Unknown station '%s'. Use --list-stations to see options.\n", optarg);
                     return -1;
                 }
-                config.carrier_frequency = freq;
+                cfg->carrier_frequency = freq;
                 printf("Selected station: %s (%.1f kHz)\n", optarg, freq / 1000.0f);
                 break;
             }
             
             case 'm':
                 if (strcmp(optarg, "simple") == 0) {
-                    config.signal_mode = SIGNAL_MODE_SIMPLE;
+                    cfg->signal_mode = SIGNAL_MODE_SIMPLE;
                 } else if (strcmp(optarg, "square") == 0) {
-                    config.signal_mode = SIGNAL_MODE_SQUARE;
+                    cfg->signal_mode = SIGNAL_MODE_SQUARE;
                 } else if (strcmp(optarg, "sigma") == 0) {
-                    config.signal_mode = SIGNAL_MODE_SIGMA_DELTA;
+                    cfg->signal_mode = SIGNAL_MODE_SIGMA_DELTA;
                 } else if (strcmp(optarg, "sine") == 0) {
-                    config.signal_mode = SIGNAL_MODE_SINE_WAVE;
+                    cfg->signal_mode = SIGNAL_MODE_SINE_WAVE;
                 } else if (strcmp(optarg, "predist") == 0) {
-                    config.signal_mode = SIGNAL_MODE_PREDISTORTION;
+                    cfg->signal_mode = SIGNAL_MODE_PREDISTORTION;
                 } else if (strcmp(optarg, "oversample") == 0) {
-                    config.signal_mode = SIGNAL_MODE_OVERSAMPLED;
+                    cfg->signal_mode = SIGNAL_MODE_OVERSAMPLED;
+                } else if (strcmp(optarg, "dac") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_PARALLEL_DAC;
+                } else if (strcmp(optarg, "multiphase") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_MULTIPHASE;
+                } else if (strcmp(optarg, "cquam") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_CQAM;
+                } else if (strcmp(optarg, "dsb") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_DSB_SC;
+                } else if (strcmp(optarg, "usb") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_USB;
+                } else if (strcmp(optarg, "lsb") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_LSB;
+                } else if (strcmp(optarg, "multi") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_MULTICARRIER;
+                } else if (strcmp(optarg, "finepwm") == 0) {
+                    cfg->signal_mode = SIGNAL_MODE_FINE_PWM;
                 } else {
                     printf("Error: Invalid signal mode '%s'\n", optarg);
                     return -1;
@@ -371,19 +1118,19 @@ static int parse_command_line(int argc, char* argv[]) {
                 break;
                 
             case 'd':
-                config.modulation_depth = atoi(optarg);
-                if (config.modulation_depth > 100) {
+                cfg->modulation_depth = atoi(optarg);
+                if (cfg->modulation_depth > 100) {
                     printf("Error: Modulation depth must be 0-100%%\n");
                     return -1;
                 }
                 break;
                 
             case 'e':
-                config.educational_mode = true;
+                cfg->educational_mode = true;
                 break;
                 
             case 'v':
-                config.verbose_analysis = true;
+                cfg->verbose_analysis = true;
                 break;
                 
             case 'h':
@@ -395,30 +1142,30 @@ static int parse_command_line(int argc, char* argv[]) {
                 return 1;
                 
             case 1001:  // oversample
-                config.oversampling_rate = atoi(optarg);
-                if (config.oversampling_rate < 1 || config.oversampling_rate > 32) {
+                cfg->oversampling_rate = atoi(optarg);
+                if (cfg->oversampling_rate < 1 || cfg->oversampling_rate > 32) {
                     printf("Error: Oversampling rate must be 1-32\n");
                     return -1;
                 }
                 break;
                 
             case 1002:  // predistortion
-                config.enable_predistortion = true;
+                cfg->enable_predistortion = true;
                 break;
                 
             case 1003:  // filter
                 if (strcmp(optarg, "none") == 0) {
-                    config.filter_mode = FILTER_MODE_NONE;
+                    cfg->filter_mode = FILTER_MODE_NONE;
                 } else if (strcmp(optarg, "lowpass") == 0) {
-                    config.filter_mode = FILTER_MODE_LOWPASS;
+                    cfg->filter_mode = FILTER_MODE_LOWPASS;
                 } else if (strcmp(optarg, "bp-iir") == 0) {
-                    config.filter_mode = FILTER_MODE_BANDPASS_IIR;
+                    cfg->filter_mode = FILTER_MODE_BANDPASS_IIR;
                 } else if (strcmp(optarg, "bp-fir") == 0) {
-                    config.filter_mode = FILTER_MODE_BANDPASS_FIR;
+                    cfg->filter_mode = FILTER_MODE_BANDPASS_FIR;
                 } else if (strcmp(optarg, "bp-ellip") == 0) {
-                    config.filter_mode = FILTER_MODE_BANDPASS_ELLIPTIC;
+                    cfg->filter_mode = FILTER_MODE_BANDPASS_ELLIPTIC;
                 } else if (strcmp(optarg, "multiband") == 0) {
-                    config.filter_mode = FILTER_MODE_MULTIBAND;
+                    cfg->filter_mode = FILTER_MODE_MULTIBAND;
                 } else {
                     printf("Error: Invalid filter mode '%s'\n", optarg);
                     return -1;
@@ -426,54 +1173,54 @@ static int parse_command_line(int argc, char* argv[]) {
                 break;
                 
             case 1004:  // bandwidth
-                config.filter_bandwidth = atof(optarg);
+                cfg->filter_bandwidth = atof(optarg);
                 break;
                 
             case 1005:  // order
-                config.filter_order = atoi(optarg);
-                if (config.filter_order < 1 || config.filter_order > 16) {
+                cfg->filter_order = atoi(optarg);
+                if (cfg->filter_order < 1 || cfg->filter_order > 16) {
                     printf("Error: Filter order must be 1-16\n");
                     return -1;
                 }
                 break;
                 
             case 1006:  // spectrum
-                config.spectrum_analysis = true;
+                cfg->spectrum_analysis = true;
                 break;
                 
             case 1007:  // harmonics
-                config.harmonic_analysis = true;
+                cfg->harmonic_analysis = true;
                 break;
                 
             case 1008:  // no-safety
-                config.enable_safety_limits = false;
+                cfg->enable_safety_limits = false;
                 printf("Warning: Safety limits disabled!\n");
                 break;
                 
             case 1009:  // dummy-load-check
-                config.dummy_load_check = true;
+                cfg->dummy_load_check = true;
                 break;
                 
             case 1010:  // max-power
-                config.max_power_mw = atoi(optarg);
+                cfg->max_power_mw = atoi(optarg);
                 break;
                 
             case 1011:  // time-limit
-                config.transmission_time_limit = atoi(optarg);
+                cfg->transmission_time_limit = atoi(optarg);
                 break;
                 
             case 1012:  // best-quality / max-quality
                 // Enable all best quality options
-                config.signal_mode = SIGNAL_MODE_OVERSAMPLED;
-                config.filter_mode = FILTER_MODE_BANDPASS_ELLIPTIC;
-                config.enable_predistortion = true;
-                config.oversampling_rate = 16;
-                config.verbose_analysis = true;
-                config.spectrum_analysis = true;
-                config.harmonic_analysis = true;
-                config.filter_bandwidth = 15000;
-                config.filter_order = 8;
-                config.modulation_depth = 85;  // Slightly higher for best quality
+                cfg->signal_mode = SIGNAL_MODE_OVERSAMPLED;
+                cfg->filter_mode = FILTER_MODE_BANDPASS_ELLIPTIC;
+                cfg->enable_predistortion = true;
+                cfg->oversampling_rate = 16;
+                cfg->verbose_analysis = true;
+                cfg->spectrum_analysis = true;
+                cfg->harmonic_analysis = true;
+                cfg->filter_bandwidth = 15000;
+                cfg->filter_order = 8;
+                cfg->modulation_depth = 85;  // Slightly higher for best quality
                 printf("Best Quality Mode Enabled:\n");
                 printf("- Signal: Oversampled with 16x oversampling\n");
                 printf("- Filter: Elliptic bandpass (±7.5kHz)\n");
@@ -482,6 +1229,150 @@ static int parse_command_line(int argc, char* argv[]) {
                 printf("- Modulation: 85%% depth\n");
                 break;
                 
+            case 1013:  // source
+                if (strcmp(optarg, "sd") == 0) {
+                    cfg->audio_source = AUDIO_SOURCE_SD;
+                } else if (strcmp(optarg, "xip") == 0) {
+                    cfg->audio_source = AUDIO_SOURCE_XIP_FLASH;
+                } else if (strcmp(optarg, "ram") == 0) {
+                    cfg->audio_source = AUDIO_SOURCE_RAM_LOOP;
+                } else if (strcmp(optarg, "test") == 0) {
+                    cfg->audio_source = AUDIO_SOURCE_TEST_SIGNAL;
+                } else if (strcmp(optarg, "usb") == 0) {
+                    cfg->audio_source = AUDIO_SOURCE_USB_STREAM;
+                } else {
+                    printf("Error: Invalid audio source '%s'\n", optarg);
+                    return -1;
+                }
+                break;
+                
+            case 1014:  // test-signal
+                if (strcmp(optarg, "tone") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_TONE;
+                } else if (strcmp(optarg, "imd") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_TWO_TONE;
+                } else if (strcmp(optarg, "sweep") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_SWEEP;
+                } else if (strcmp(optarg, "white") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_WHITE_NOISE;
+                } else if (strcmp(optarg, "pink") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_PINK_NOISE;
+                } else if (strcmp(optarg, "silence") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_SILENCE;
+                } else if (strcmp(optarg, "dpd-steps") == 0) {
+                    cfg->test_signal = TEST_SIGNAL_DPD_STEPS;
+                } else {
+                    printf("Error: Invalid test signal '%s'\n", optarg);
+                    return -1;
+                }
+                cfg->audio_source = AUDIO_SOURCE_TEST_SIGNAL;
+                break;
+                
+            case 1015:  // test-freq
+            case 1016:  // test-freq2
+            {
+                uint32_t freq = atoi(optarg);
+                if (freq < 1 || freq >= cfg->audio_sample_rate / 2) {
+                    printf("Error: Test frequency must be 1-%d Hz\n", cfg->audio_sample_rate / 2 - 1);
+                    return -1;
+                }
+                if (c == 1015) {
+                    cfg->test_frequency = freq;
+                } else {
+                    cfg->test_frequency2 = freq;
+                }
+                break;
+            }
+            
+            case 1017:  // seed
+                cfg->test_seed = strtoul(optarg, NULL, 0);
+                break;
+                
+            case 1018:  // playlist
+                cfg->playlist = optarg;
+                cfg->audio_source = AUDIO_SOURCE_SD;
+                break;
+                
+            case 1019:  // no-governor
+                cfg->enable_governor = false;
+                break;
+                
+            case 1020:  // plan-stations
+                list_clock_plans(cfg);
+                return 1;
+                
+            case 1021: {  // overclock
+                uint8_t profile = 0;
+                while (profile < NUM_OVERCLOCK_PROFILES &&
+                       strcasecmp(optarg, overclock_profiles[profile].name) != 0) {
+                    profile++;
+                }
+                if (profile == NUM_OVERCLOCK_PROFILES) {
+                    printf("Error: Unknown overclock profile '%s' (stock, 200, 250, 300)\n", optarg);
+                    return -1;
+                }
+                cfg->overclock_profile = profile;
+                break;
+            }
+                
+            case 1022:  // sd-order
+                cfg->sigma_delta_order = atoi(optarg);
+                if (cfg->sigma_delta_order < 2 || cfg->sigma_delta_order > 3) {
+                    printf("Error: Sigma-delta order must be 2 or 3\n");
+                    return -1;
+                }
+                break;
+                
+            case 1023:  // dac-bits
+                cfg->dac_bits = atoi(optarg);
+                if (cfg->dac_bits != 4 && cfg->dac_bits != 6 && cfg->dac_bits != 8) {
+                    printf("Error: DAC width must be 4, 6 or 8 bits\n");
+                    return -1;
+                }
+                break;
+                
+            case 1024: {  // stations
+                cfg->station_count = 0;
+                if (strcmp(optarg, "none") == 0) break;
+                
+                char list[128];
+                strncpy(list, optarg, sizeof(list) - 1);
+                list[sizeof(list) - 1] = '\0';
+                char* save = NULL;
+                for (char* spec = strtok_r(list, ",", &save); spec; spec = strtok_r(NULL, ",", &save)) {
+                    if (cfg->station_count == MULTICARRIER_MAX - 1) {
+                        printf("Error: At most %d extra stations\n", MULTICARRIER_MAX - 1);
+                        return -1;
+                    }
+                    station_config_t* station = &cfg->stations[cfg->station_count];
+                    char* fields = NULL;
+                    char* field = strtok_r(spec, ":", &fields);
+                    char* depth = strtok_r(NULL, ":", &fields);
+                    char* tone = strtok_r(NULL, ":", &fields);
+                    
+                    station->frequency = find_station_frequency(field);
+                    if (station->frequency == 0) station->frequency = atoi(field);
+                    station->depth = depth ? atoi(depth) : cfg->modulation_depth;
+                    station->tone_hz = tone ? atoi(tone) : 400 * (cfg->station_count + 2);
+                    if (station->frequency < 10000 || station->depth > 100) {
+                        printf("Error: Invalid station '%s'\n", field);
+                        return -1;
+                    }
+                    cfg->station_count++;
+                }
+                cfg->signal_mode = SIGNAL_MODE_MULTICARRIER;
+                break;
+            }
+                
+            case 1025:  // dpd-table: read from the SD card at the next start
+                snprintf(dpd_table_request, sizeof(dpd_table_request), "%s", optarg);
+                cfg->enable_predistortion = true;
+                break;
+                
+            case 1026:  // no-noise-shaping
+                cfg->noise_shaping = false;
+                break;
+                
             default:
                 print_usage(argv[0]);
                 return -1;
@@ -490,12 +1381,16 @@ static int parse_command_line(int argc, char* argv[]) {
     
     // Handle remaining arguments (WAV filename)
     if (optind < argc) {
-        config.wav_filename = argv[optind];
+        cfg->wav_filename = argv[optind];
     }
     
     return 0;
 }
 
+static int parse_command_line(int argc, char* argv[]) {
+    return parse_options(&config, argc, argv);
+}
+
 // ============================================================================
 // SIGNAL PROCESSING FUNCTIONS
 // ============================================================================
@@ -520,26 +1415,15 @@ void generate_sine_lut() {
     }
 }
 
-// Design IIR Butterworth bandpass filter
-void design_butterworth_bandpass() {
-    if (config.verbose_analysis) {
-        printf("Designing IIR Butterworth bandpass filter:\n");
-        printf("- Center: %.1f Hz\n", (float)config.carrier_frequency);
-        printf("- Bandwidth: %.1f Hz\n", config.filter_bandwidth);
-        printf("- Order: %d\n", config.filter_order);
-    }
-    
+// Bandpass biquad cascade centred on a carrier (delay lines cleared)
+static void design_bandpass_sections(biquad_section_t* sections, uint8_t count, uint32_t carrier) {
     float fs = config.audio_sample_rate * config.oversampling_rate;
-    float wc = 2.0f * M_PI * config.carrier_frequency / fs;
-    float bw = 2.0f * M_PI * config.filter_bandwidth / fs;
+    float wc = 2.0f * M_PI * carrier / fs;
     
-    num_filter_sections = (config.filter_order + 1) / 2;
-    if (num_filter_sections > 4) num_filter_sections = 4;
-    
-    for (uint8_t i = 0; i < num_filter_sections; i++) {
-        biquad_section_t* section = &filter_sections[i];
+    for (uint8_t i = 0; i < count; i++) {
+        biquad_section_t* section = &sections[i];
         
-        float q = config.carrier_frequency / config.filter_bandwidth;
+        float q = carrier / config.filter_bandwidth;
         float cos_wc = cosf(wc);
         float sin_wc = sinf(wc);
         float alpha = sin_wc * sinhf(logf(2.0f)/2.0f * q * wc/sin_wc);
@@ -559,27 +1443,35 @@ void design_butterworth_bandpass() {
             section->x[j] = section->y[j] = 0.0f;
         }
     }
+}
+
+// Design IIR Butterworth bandpass filter
+void design_butterworth_bandpass() {
+    if (config.verbose_analysis) {
+        printf("Designing IIR Butterworth bandpass filter:\n");
+        printf("- Center: %.1f Hz\n", (float)config.carrier_frequency);
+        printf("- Bandwidth: %.1f Hz\n", config.filter_bandwidth);
+        printf("- Order: %d\n", config.filter_order);
+    }
+    
+    num_filter_sections = (config.filter_order + 1) / 2;
+    if (num_filter_sections > 4) num_filter_sections = 4;
+    
+    design_bandpass_sections(filter_sections, num_filter_sections, config.carrier_frequency);
     
     if (config.verbose_analysis) {
         printf("Bandpass filter designed: %d sections\n", num_filter_sections);
     }
 }
 
-// Design FIR windowed sinc bandpass filter
-void design_fir_bandpass() {
-    fir_length = config.filter_order * 8;  // Higher order for FIR
-    if (fir_length > 256) fir_length = 256;
-    
-    if (config.verbose_analysis) {
-        printf("Designing FIR bandpass filter: %d taps\n", fir_length);
-    }
-    
+// Windowed-sinc bandpass taps around the carrier
+static void design_fir_taps(float* taps, int length, uint32_t carrier) {
     float fs = config.audio_sample_rate * config.oversampling_rate;
-    float f1 = (config.carrier_frequency - config.filter_bandwidth/2.0f) / fs;
-    float f2 = (config.carrier_frequency + config.filter_bandwidth/2.0f) / fs;
+    float f1 = (carrier - config.filter_bandwidth/2.0f) / fs;
+    float f2 = (carrier + config.filter_bandwidth/2.0f) / fs;
     
-    for (int i = 0; i < fir_length; i++) {
-        int n = i - fir_length/2;
+    for (int i = 0; i < length; i++) {
+        int n = i - length/2;
         float h;
         
         if (n == 0) {
@@ -591,9 +1483,32 @@ void design_fir_bandpass() {
         }
         
         // Hamming window
-        float window = 0.54f - 0.46f * cosf(2.0f * M_PI * i / (fir_length - 1));
-        fir_coefficients[i] = h * window;
+        float window = 0.54f - 0.46f * cosf(2.0f * M_PI * i / (length - 1));
+        taps[i] = h * window;
+    }
+}
+
+// Full kernel plus the shorter designs for the governor's reduced rungs
+static void design_fir_bank(float* bank, uint8_t length, uint32_t carrier) {
+    design_fir_taps(bank, length, carrier);
+    design_fir_taps(bank + 256, length >> 1, carrier);
+    design_fir_taps(bank + 256 + 128, length >> 2, carrier);
+}
+
+// Design FIR windowed sinc bandpass filter
+void design_fir_bandpass() {
+    int length = config.filter_order * 8;  // Higher order for FIR
+    if (length > 255) length = 255;
+    fir_length = length;
+    
+    if (config.verbose_analysis) {
+        printf("Designing FIR bandpass filter: %d taps\n", fir_length);
     }
+    
+    design_fir_bank(fir_coefficients, fir_length, config.carrier_frequency);
+    
+    active_fir_coefficients = fir_coefficients;
+    active_fir_length = fir_length;
 }
 
 // Process biquad section
@@ -617,76 +1532,277 @@ float process_biquad(biquad_section_t* section, float input) {
     return output;
 }
 
-// Process FIR filter
+// Process FIR filter (active governor rung)
 float process_fir_filter(float input) {
     static float delay_line[256] = {0};
     static uint8_t delay_index = 0;
+    uint8_t length = active_fir_length;
+    
+    if (length == 0) return input;
+    if (delay_index >= length) delay_index = 0;  // Rung changed
     
     delay_line[delay_index] = input;
-    delay_index = (delay_index + 1) % fir_length;
+    delay_index = (delay_index + 1) % length;
     
     float output = 0.0f;
-    for (int i = 0; i < fir_length; i++) {
-        uint8_t sample_index = (delay_index + i) % fir_length;
-        output += delay_line[sample_index] * fir_coefficients[i];
+    for (int i = 0; i < length; i++) {
+        uint8_t sample_index = (delay_index + i) % length;
+        output += delay_line[sample_index] * active_fir_coefficients[i];
     }
     
     return output;
 }
 
-// Apply digital pre-distortion
-float apply_predistortion(float input) {
-    // Third-order polynomial pre-distortion
-    float x = input;
-    return x - 0.1f * x*x*x + 0.05f * x*x*x*x*x;
+// Built-in pre-distortion curve, used until a fitted table is loaded:
+// the fixed x - 0.1x^3 + 0.05x^5 on the modulation x = envelope - 1, as a
+// gain per table point
+void design_dpd_default() {
+    for (int k = 1; k < DPD_LUT_POINTS; k++) {
+        float envelope = (float)(k << DPD_LUT_SHIFT) / ENVELOPE_UNITY;
+        float x = envelope - 1.0f;
+        float drive = 1.0f + x - 0.1f * x*x*x + 0.05f * x*x*x*x*x;
+        dpd_table.gain[k] = (int16_t)lroundf(drive / envelope * ENVELOPE_UNITY);
+        dpd_table.phase[k] = 0;
+    }
+    dpd_table.gain[0] = dpd_table.gain[1];  // Below the 0.1 envelope limit
+    dpd_table.phase[0] = 0;
+    dpd_table_fitted = false;
 }
 
-// Generate AM modulated signal
-uint32_t generate_am_signal(int16_t audio_sample) {
-    // Normalize audio sample
-    float audio_norm = (float)audio_sample / 32768.0f;
-    
-    // Apply modulation
-    float modulated = 1.0f + (config.modulation_depth / 100.0f) * audio_norm;
-    if (modulated < 0.1f) modulated = 0.1f;
-    if (modulated > 1.9f) modulated = 1.9f;
-    
-    uint32_t output = 0;
+// Pre-distortion table written by dpd_fit.py: one "gain phase" pair per
+// line (Q12, 1/65536 turn) for each of the DPD_LUT_POINTS levels in order;
+// '#' starts a comment. The live table is only replaced by a complete one.
+bool dpd_load_table(const char* path) {
+    FIL file;
+    if (f_open(&file, path, FA_READ) != FR_OK) {
+        printf("Error: Cannot open pre-distortion table '%s'\n", path);
+        return false;
+    }
     
-    switch (config.signal_mode) {
-        case SIGNAL_MODE_SIMPLE:
-        case SIGNAL_MODE_SINE_WAVE: {
-            // High-quality sine wave
-            uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
-            uint32_t base_amplitude = waveform_lut[lut_index];
-            output = (uint32_t)(base_amplitude * modulated);
-            break;
-        }
-        
-        case SIGNAL_MODE_SQUARE: {
-            // Basic square wave
-            bool high = (phase_accumulator & 0x80000000) != 0;
-            output = high ? (uint32_t)(4095 * modulated) : 0;
-            break;
-        }
+    dpd_table_t table;
+    uint32_t points = 0;
+    bool valid = true;
+    char line[64];
+    while (valid && f_gets(line, sizeof(line), &file)) {
+        line[strcspn(line, "#\r\n")] = '\0';
+        char* end;
+        long gain = strtol(line, &end, 10);
+        if (end == line) continue;  // Blank or comment
+        long phase = strtol(end, &end, 10);
         
-        case SIGNAL_MODE_SIGMA_DELTA: {
-            // Simplified sigma-delta
-            uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
-            uint32_t base_amplitude = waveform_lut[lut_index];
-            static uint32_t error = 0;
-            uint32_t corrected = (uint32_t)(base_amplitude * modulated) + error;
-            output = (corrected > 2048) ? 4095 : 0;
-            error = corrected - output;
-            break;
+        valid = points < DPD_LUT_POINTS && gain > 0 && gain <= INT16_MAX &&
+                phase >= INT16_MIN && phase <= INT16_MAX;
+        if (valid) {
+            table.gain[points] = (int16_t)gain;
+            table.phase[points] = (int16_t)phase;
+            points++;
         }
-        
+    }
+    f_close(&file);
+    
+    if (!valid || points != DPD_LUT_POINTS) {
+        printf("Error: '%s' is not a %d-point pre-distortion table\n", path, DPD_LUT_POINTS);
+        return false;
+    }
+    dpd_table = table;
+    dpd_table_fitted = true;
+    return true;
+}
+
+// Core 0 (audio rate): drive envelope for a wanted one, and the carrier
+// phase correction for it. One table lookup, one interpolation each.
+static inline int32_t apply_predistortion(int32_t envelope, int16_t* phase) {
+    uint32_t index = (uint32_t)envelope >> DPD_LUT_SHIFT;
+    int32_t frac = envelope & ((1 << DPD_LUT_SHIFT) - 1);
+    if (index >= DPD_LUT_POINTS - 1) {
+        index = DPD_LUT_POINTS - 2;
+        frac = 1 << DPD_LUT_SHIFT;
+    }
+    
+    int32_t g0 = dpd_table.gain[index];
+    int32_t gain = g0 + (((dpd_table.gain[index + 1] - g0) * frac) >> DPD_LUT_SHIFT);
+    int32_t p0 = dpd_table.phase[index];
+    *phase = (int16_t)(p0 + (((dpd_table.phase[index + 1] - p0) * frac) >> DPD_LUT_SHIFT));
+    
+    int32_t drive = (envelope * gain) >> 12;
+    return drive > 2 * ENVELOPE_UNITY ? 2 * ENVELOPE_UNITY : drive;
+}
+
+// Core 0 (audio rate): audio sample -> wanted carrier envelope, Q12.
+// Modulation depth and clamping happen here so the RF-rate loop on core 1
+// only multiplies by the envelope; audio_rate_sample() pre-distorts.
+uint16_t compute_envelope(int16_t audio_sample) {
+    int32_t depth_q12 = (config.modulation_depth * ENVELOPE_UNITY) / 100;
+    int32_t envelope = ENVELOPE_UNITY + ((depth_q12 * audio_sample) >> 15);
+    
+    // Same 0.1 .. 1.9 limits as before
+    const int32_t env_min = ENVELOPE_UNITY / 10;
+    const int32_t env_max = ENVELOPE_UNITY * 19 / 10;
+    if (envelope < env_min) envelope = env_min;
+    if (envelope > env_max) envelope = env_max;
+    
+    return (uint16_t)envelope;
+}
+
+// arctan(2^-k) in 1/65536 turns
+static const int16_t cordic_atan_table[CORDIC_ITERATIONS] = {
+    8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1
+};
+
+// Vectoring CORDIC: angle of (x, y) for x > 0, in 1/65536 turns. Shifts
+// and adds only; the gain of the rotations does not affect the angle.
+static int16_t cordic_atan2(int32_t x, int32_t y) {
+    int32_t angle = 0;
+    for (int k = 0; k < CORDIC_ITERATIONS; k++) {
+        int32_t dx = y >> k;
+        int32_t dy = x >> k;
+        if (y > 0) {
+            x += dx; y -= dy; angle += cordic_atan_table[k];
+        } else {
+            x -= dx; y += dy; angle -= cordic_atan_table[k];
+        }
+    }
+    return (int16_t)angle;
+}
+
+// Core 0 (audio rate): C-QUAM carrier phase. The QUAM signal has the
+// envelope (1 + L+R) in phase and L-R plus the pilot in quadrature; C-QUAM
+// keeps its angle but transmits the L+R envelope, so mono receivers hear
+// plain AM. The angle is positive when L > R, as the carrier phase of
+// cos(wt + phase). Core 1 only turns phase steps into edge times.
+static int16_t cqam_phase(uint16_t envelope, int16_t difference) {
+    int32_t depth_q12 = (config.modulation_depth * ENVELOPE_UNITY) / 100;
+    int32_t pilot = (int32_t)waveform_lut[cqam_pilot_phase >> 20] - 2048;
+    int32_t quadrature = ((depth_q12 * difference) >> 15) +
+                         pilot * CQAM_PILOT_DEPTH_PCT * ENVELOPE_UNITY / (100 * 2048);
+    cqam_pilot_phase += cqam_pilot_step;
+    
+    return cordic_atan2((int32_t)envelope << 8, quadrature << 8);
+}
+
+// Windowed 2 / (pi k) for odd k; Hamming taken about the centre tap
+void design_hilbert() {
+    const int centre = HILBERT_LENGTH / 2;
+    for (int j = 0; j < (int)count_of(hilbert_taps); j++) {
+        int k = 2 * j + 1;
+        float window = 0.54f + 0.46f * cosf(M_PI * k / centre);
+        hilbert_taps[j] = (int16_t)lroundf(32768.0f * 2.0f / (M_PI * k) * window);
+    }
+    memset(&hilbert, 0, sizeof(hilbert));
+}
+
+// Core 0 (audio rate): next Hilbert output, and the input delayed by the
+// filter's HILBERT_LENGTH / 2 samples so the two stay in quadrature
+static int16_t hilbert_step(hilbert_state_t* state, int16_t input, int16_t* delayed) {
+    state->position = (state->position + 1) % HILBERT_LENGTH;
+    state->history[state->position] = input;
+    state->history[state->position + HILBERT_LENGTH] = input;
+    
+    // Oldest to newest: history[position + 1 .. position + HILBERT_LENGTH]
+    const int16_t* centre = &state->history[state->position + 1 + HILBERT_LENGTH / 2];
+    int32_t acc = 0;
+    for (int j = 0; j < (int)count_of(hilbert_taps); j++) {
+        int k = 2 * j + 1;
+        acc += hilbert_taps[j] * (centre[-k] - centre[k]);
+    }
+    *delayed = centre[0];
+    return (int16_t)(acc >> 15);
+}
+
+// Core 0 (audio rate): envelope of extra station k, from its own test tone
+// at -6 dBFS and its own depth
+static uint16_t station_envelope(uint32_t k) {
+    const station_config_t* station = &config.stations[k];
+    int32_t tone = 0;
+    if (station->tone_hz) {
+        tone = ((int32_t)waveform_lut[station_tone_phase[k] >> 20] - 2048) * 8;
+        station_tone_phase[k] += station_tone_step[k];
+    }
+    int32_t depth_q12 = (station->depth * ENVELOPE_UNITY) / 100;
+    return (uint16_t)(ENVELOPE_UNITY + ((depth_q12 * tone) >> 15));
+}
+
+// Core 0 (audio rate): one pipeline entry. Every mode gets the envelope;
+// C-QUAM adds the carrier phase, SSB splits it into I (offset by unity,
+// like the envelope) and Q, multi-carrier adds the other stations.
+// Pre-distortion acts on the carrier amplitude, so it is left out where
+// the envelope entry is not what the PA sees (sideband and summed modes);
+// its phase correction has somewhere to go only in C-QUAM. Both phases are
+// carrier advance, so the table's correction (dpd_fit.py's exp(+j phase))
+// simply adds to the QUAM angle.
+static inline void audio_rate_sample(pipeline_block_t* block, uint32_t i, int16_t sample,
+                                     int16_t difference) {
+    block->envelope[i] = compute_envelope(sample);
+    bool carrier_envelope = config.signal_mode != SIGNAL_MODE_DSB_SC &&
+                            config.signal_mode != SIGNAL_MODE_USB &&
+                            config.signal_mode != SIGNAL_MODE_LSB &&
+                            config.signal_mode != SIGNAL_MODE_MULTICARRIER;
+    if ((config.signal_mode == SIGNAL_MODE_PREDISTORTION || config.enable_predistortion) &&
+        active_predistortion == PREDISTORT_LUT && carrier_envelope) {
+        int16_t correction;
+        uint16_t wanted = block->envelope[i];
+        block->envelope[i] = (uint16_t)apply_predistortion(wanted, &correction);
+        if (config.signal_mode == SIGNAL_MODE_CQAM) {
+            block->phase[i] = cqam_phase(wanted, difference) + correction;
+        }
+    } else if (config.signal_mode == SIGNAL_MODE_CQAM) {
+        block->phase[i] = cqam_phase(block->envelope[i], difference);
+    }
+    
+    if (config.signal_mode == SIGNAL_MODE_USB || config.signal_mode == SIGNAL_MODE_LSB) {
+        int16_t in_phase;
+        block->quadrature[i] = hilbert_step(&hilbert, block->envelope[i] - ENVELOPE_UNITY,
+                                            &in_phase);
+        block->envelope[i] = ENVELOPE_UNITY + in_phase;
+    } else if (config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+        for (uint32_t k = 0; k < config.station_count; k++) {
+            block->station_envelope[k][i] = station_envelope(k);
+        }
+    }
+}
+
+// Core 1 (RF rate): NCO + modulation for one envelope sample
+uint32_t generate_am_signal(uint16_t envelope) {
+    uint32_t output = 0;
+    
+    switch (config.signal_mode) {
+        case SIGNAL_MODE_SIMPLE:
+        case SIGNAL_MODE_SINE_WAVE:
+        case SIGNAL_MODE_SIGMA_DELTA:    // Packed words come from sigma_delta_word(),
+        case SIGNAL_MODE_PARALLEL_DAC:   // parallel_dac_word()
+        case SIGNAL_MODE_MULTIPHASE:     // multiphase_word()
+        case SIGNAL_MODE_CQAM:           // cqam_word(),
+        case SIGNAL_MODE_MULTICARRIER:   // multicarrier_word()
+        case SIGNAL_MODE_FINE_PWM: {     // and fine_pwm_word()
+            // High-quality sine wave
+            uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
+            uint32_t base_amplitude = waveform_lut[lut_index];
+            output = (base_amplitude * envelope) >> 12;
+            break;
+        }
+        
+        case SIGNAL_MODE_DSB_SC:
+        case SIGNAL_MODE_USB:            // The sideband modes run generate_ssb_signal()
+        case SIGNAL_MODE_LSB: {
+            // Audio times the carrier, no carrier term: mid-scale is zero
+            uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
+            int32_t sine = (int32_t)waveform_lut[lut_index] - 2048;
+            output = 2048 + ((((int32_t)envelope - ENVELOPE_UNITY) * sine) >> 12);
+            break;
+        }
+        
+        case SIGNAL_MODE_SQUARE: {
+            // Basic square wave
+            bool high = (phase_accumulator & 0x80000000) != 0;
+            output = high ? (4095 * envelope) >> 12 : 0;
+            break;
+        }
+        
         case SIGNAL_MODE_PREDISTORTION: {
-            // Pre-distortion + sine wave
-            float predist_mod = apply_predistortion(modulated - 1.0f) + 1.0f;
+            // Sine wave; envelope already pre-distorted on core 0
             uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
             uint32_t base_amplitude = waveform_lut[lut_index];
-            output = (uint32_t)(base_amplitude * predist_mod);
+            output = (base_amplitude * envelope) >> 12;
             break;
         }
         
@@ -694,9 +1810,9 @@ uint32_t generate_am_signal(int16_t audio_sample) {
             // Oversampled with filtering
             uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
             float base_amplitude = waveform_lut[lut_index] / 4095.0f;
-            float filtered = (config.filter_mode != FILTER_MODE_NONE) ? 
-                           process_fir_filter(base_amplitude * modulated) : 
-                           base_amplitude * modulated;
+            float modulated = base_amplitude * envelope / (float)ENVELOPE_UNITY;
+            float filtered = (config.filter_mode == FILTER_MODE_BANDPASS_FIR) ? 
+                           process_fir_filter(modulated) : modulated;
             output = (uint32_t)(filtered * 4095);
             break;
         }
@@ -711,191 +1827,2770 @@ uint32_t generate_am_signal(int16_t audio_sample) {
     return output;
 }
 
+// Core 1 (RF rate): quadrature upconversion for SSB. I rides on the NCO's
+// sine and Q on its cosine, a quarter of the table further on; the sign
+// of Q picks the sideband. Half scale keeps I and Q peaks inside 12 bits.
+uint32_t generate_ssb_signal(uint16_t envelope, int16_t quadrature) {
+    uint32_t lut_index = (phase_accumulator >> 20) & 0xFFF;
+    int32_t sine = (int32_t)waveform_lut[lut_index] - 2048;
+    int32_t cosine = (int32_t)waveform_lut[(lut_index + 1024) & 0xFFF] - 2048;
+    int32_t in_phase = (int32_t)envelope - ENVELOPE_UNITY;
+    int32_t q = config.signal_mode == SIGNAL_MODE_LSB ? -quadrature : quadrature;
+    int32_t output = 2048 + ((in_phase * sine + q * cosine) >> 13);
+    
+    phase_accumulator += phase_increment;
+    
+    if (output < 0) output = 0;
+    if (output > 4095) output = 4095;
+    return (uint32_t)output;
+}
+
+// Noise transfer function of the packed modulators. The PIO shifts out
+// 2 * oversampling samples per carrier cycle, so the carrier sits at a
+// fixed w0 = pi / oversampling and the NTF zeros go there instead of DC:
+//   2nd order: 1 - 2cos(w0)z^-1 + z^-2
+//   3rd order: (1 - z^-1)(1 - 2cos(w0)z^-1 + z^-2) / D(z), with D(z) the
+//              poles of a Butterworth high-pass that keep max |NTF| at 1.5
+void design_sigma_delta(uint8_t order, uint32_t oversampling) {
+    static const int32_t poles_q12[3] = {-9009, 6920, -1820};  // 1 - 2.1996z^-1 + 1.6893z^-2 - 0.4444z^-3
+    float two_cos = 2.0f * cosf(M_PI / oversampling);
+    float zeros[3] = {-two_cos, 1.0f, 0.0f};
+    
+    if (order == 3) {
+        zeros[0] = -(1.0f + two_cos);
+        zeros[1] = 1.0f + two_cos;
+        zeros[2] = -1.0f;
+    }
+    
+    for (int k = 0; k < 3; k++) {
+        sigma_delta_feedback_taps[k] = (order == 3) ? poles_q12[k] : 0;
+        sigma_delta_error_taps[k] = lroundf(zeros[k] * 4096) - sigma_delta_feedback_taps[k];
+    }
+    sigma_delta_phase_step = (uint32_t)((1ULL << 32) / (2 * oversampling));
+    memset(&sigma_delta, 0, sizeof(sigma_delta));
+}
+
+// 32 modulator decisions packed MSB first, the order the PIO shifts them
+// out. Error-feedback form: v = x + (NTF - 1)e, y = sign(v), e = y - v.
+// At 100% modulation the input peaks at half scale, inside the stable
+// range of both loops; the error clamp pulls an overloaded loop back.
+uint32_t sigma_delta_word(sigma_delta_state_t* state, uint16_t envelope) {
+    const int32_t* ce = sigma_delta_error_taps;
+    const int32_t* cw = sigma_delta_feedback_taps;
+    bool third_order = cw[0] != 0;
+    int32_t e1 = state->error[0], e2 = state->error[1], e3 = state->error[2];
+    int32_t w1 = state->shaped[0], w2 = state->shaped[1], w3 = state->shaped[2];
+    uint32_t phase = state->phase;
+    uint32_t word = 0;
+    
+    for (int bit = 0; bit < 32; bit++) {
+        int32_t carrier = (int32_t)waveform_lut[phase >> 20] - 2048;
+        int32_t input = (carrier * (int32_t)envelope) >> 13;
+        phase += sigma_delta_phase_step;
+        
+        int32_t acc = ce[0] * e1 + ce[1] * e2;
+        if (third_order) {
+            acc += ce[2] * e3 - cw[0] * w1 - cw[1] * w2 - cw[2] * w3;
+        }
+        int32_t shaped = acc >> 12;
+        int32_t v = input + shaped;
+        bool high = v >= 0;
+        int32_t e = (high ? SIGMA_DELTA_FULL_SCALE : -SIGMA_DELTA_FULL_SCALE) - v;
+        if (e > 2 * SIGMA_DELTA_FULL_SCALE) e = 2 * SIGMA_DELTA_FULL_SCALE;
+        if (e < -2 * SIGMA_DELTA_FULL_SCALE) e = -2 * SIGMA_DELTA_FULL_SCALE;
+        
+        e3 = e2; e2 = e1; e1 = e;
+        w3 = w2; w2 = w1; w1 = shaped;
+        word = (word << 1) | high;
+    }
+    
+    state->error[0] = e1; state->error[1] = e2; state->error[2] = e3;
+    state->shaped[0] = w1; state->shaped[1] = w2; state->shaped[2] = w3;
+    state->phase = phase;
+    return word;
+}
+
+// The same loop with a dac_bits-wide quantiser for an R-2R ladder, in the
+// 12-bit code domain. Codes are packed first sample in the MSBs (five 6-bit
+// codes leave the low 2 bits unused). The error stays within an LSB, so
+// far fewer samples per carrier cycle reach the 1-bit loop's SNR.
+uint32_t parallel_dac_word(sigma_delta_state_t* state, uint16_t envelope) {
+    const int32_t* ce = sigma_delta_error_taps;
+    const int32_t* cw = sigma_delta_feedback_taps;
+    bool third_order = cw[0] != 0;
+    uint32_t bits = config.dac_bits;
+    uint32_t samples = 32 / bits;
+    int32_t shift = 12 - bits;
+    int32_t top_code = (1 << bits) - 1;
+    int32_t lsb = 1 << shift;
+    int32_t e1 = state->error[0], e2 = state->error[1], e3 = state->error[2];
+    int32_t w1 = state->shaped[0], w2 = state->shaped[1], w3 = state->shaped[2];
+    uint32_t phase = state->phase;
+    uint32_t word = 0;
+    
+    for (uint32_t n = 0; n < samples; n++) {
+        int32_t carrier = (int32_t)waveform_lut[phase >> 20] - 2048;
+        int32_t input = (carrier * (int32_t)envelope) >> 13;
+        phase += sigma_delta_phase_step;
+        
+        int32_t acc = ce[0] * e1 + ce[1] * e2;
+        if (third_order) {
+            acc += ce[2] * e3 - cw[0] * w1 - cw[1] * w2 - cw[2] * w3;
+        }
+        int32_t shaped = acc >> 12;
+        int32_t v = 2048 + input + shaped;
+        int32_t code = (v + lsb / 2) >> shift;
+        if (code < 0) code = 0;
+        if (code > top_code) code = top_code;
+        int32_t e = (code << shift) - v;
+        if (e > lsb) e = lsb;                 // Clipped at full modulation
+        if (e < -lsb) e = -lsb;
+        
+        e3 = e2; e2 = e1; e1 = e;
+        w3 = w2; w2 = w1; w1 = shaped;
+        word = (word << bits) | code;
+    }
+    
+    state->error[0] = e1; state->error[1] = e2; state->error[2] = e3;
+    state->shaped[0] = w1; state->shaped[1] = w2; state->shaped[2] = w3;
+    state->phase = phase;
+    return word << (32 - samples * bits);
+}
+
+// Output samples packed into one FIFO word (1 = a timing word)
+static uint32_t samples_per_word(const transmitter_config_t* cfg) {
+    switch (cfg->signal_mode) {
+        case SIGNAL_MODE_SIGMA_DELTA:  return 32;
+        case SIGNAL_MODE_PARALLEL_DAC:
+        case SIGNAL_MODE_MULTICARRIER: return 32 / cfg->dac_bits;
+        default:                       return 1;
+    }
+}
+
+// Core 1: next packed word for the current mode
+static inline uint32_t packed_word(sigma_delta_state_t* state, uint16_t envelope) {
+    return config.signal_mode == SIGNAL_MODE_SIGMA_DELTA ? sigma_delta_word(state, envelope)
+                                                         : parallel_dac_word(state, envelope);
+}
+
+// Multi-carrier NCO steps at the ladder's sample rate, 2 * oversampling
+// times the main carrier: the main station lands on the same phase step as
+// the DAC mode, the others wherever their frequency puts them
+static void design_multicarrier() {
+    uint64_t sample_rate = (uint64_t)config.carrier_frequency * config.oversampling_rate * 2;
+    
+    multicarrier_count = 1 + config.station_count;
+    multicarrier_gain = ENVELOPE_UNITY / multicarrier_count;
+    multicarrier_steps[0] = (uint32_t)((1ULL << 32) / (2 * config.oversampling_rate));
+    for (uint32_t k = 0; k < config.station_count; k++) {
+        multicarrier_steps[k + 1] = (uint32_t)(((uint64_t)config.stations[k].frequency << 32) /
+                                               sample_rate);
+        station_tone_phase[k] = 0;
+        station_tone_step[k] = (uint32_t)(((uint64_t)config.stations[k].tone_hz << 32) /
+                                          config.audio_sample_rate);
+    }
+    memset(&multicarrier, 0, sizeof(multicarrier));
+}
+
+// Core 1: one ladder word from `count` stations. Each station's NCO times
+// its envelope, summed and scaled so all at full modulation just fill the
+// ladder, then requantised with the error fed back once (noise zero at DC).
+static inline uint32_t multicarrier_word(multicarrier_state_t* state, const uint16_t* envelopes,
+                                         uint32_t count) {
+    uint32_t bits = config.dac_bits;
+    uint32_t samples = 32 / bits;
+    int32_t shift = 12 - bits;
+    int32_t top_code = (1 << bits) - 1;
+    int32_t lsb = 1 << shift;
+    int32_t error = state->error;
+    uint32_t word = 0;
+    
+    for (uint32_t n = 0; n < samples; n++) {
+        int32_t sum = 0;
+        for (uint32_t k = 0; k < count; k++) {
+            sum += ((int32_t)waveform_lut[state->phase[k] >> 20] - 2048) * envelopes[k];
+            state->phase[k] += multicarrier_steps[k];
+        }
+        int32_t v = 2048 + (((sum >> 13) * multicarrier_gain) >> 12) - error;
+        int32_t code = (v + lsb / 2) >> shift;
+        if (code < 0) code = 0;
+        if (code > top_code) code = top_code;
+        error = (code << shift) - v;
+        if (error > lsb) error = lsb;
+        if (error < -lsb) error = -lsb;
+        word = (word << bits) | code;
+    }
+    
+    state->error = error;
+    return word << (32 - samples * bits);
+}
+
+// Multi-phase carrier words, one per half carrier cycle of `oversampling`
+// PIO cycles: [31:22] lead, [21:12] width - 2, [11:10] pin pattern,
+// [9:0] low, taking lead + width + low + 5 cycles. Each phase is a
+// three-level square (P pulse, rest, N pulse, rest) whose fundamental goes
+// as sin(pi * width / T), so the width is the arcsine of the amplitude
+// (envelope / 2 * unity). Lead and low split the rest of the half cycle,
+// keeping the pulse centred so its phase does not move with the envelope;
+// an odd remainder leaves it half a cycle early, +-1/4 cycle of AM-PM
+// (2.8 degrees at --oversample 16). Widths stop at half - 5, and the table
+// is scaled so full envelope reaches that width instead of clipping.
+static void design_multiphase_words(uint32_t oversampling) {
+    const int32_t half = oversampling;
+    const int32_t max_width = half - 5;
+    const float max_amplitude = sinf(M_PI * max_width / (2.0f * half));
+    
+    for (int i = 0; i <= 256; i++) {
+        float width = 2.0f * half * asinf(max_amplitude * i / 256.0f) / M_PI;
+        
+        // No 1-cycle pulse: below one cycle the word is silent, which
+        // still takes the 2 cycles of the shortest pulse
+        uint32_t pattern = width >= 1.0f ? 1 : 0;
+        int32_t w = lroundf(width);
+        if (w < 2) w = 2;
+        if (w > max_width) w = max_width;
+        int32_t lead = (half - 5 - w) / 2;
+        multiphase_words[i] = ((uint32_t)lead << 22) | ((uint32_t)(w - 2) << 12) |
+                              (pattern << 10) | (uint32_t)(half - 5 - w - lead);
+    }
+}
+
+// Core 1: word for buffer position `index`; odd words drive the N pin,
+// which turns pattern 01 into 10 and leaves a silent word silent
+static inline uint32_t multiphase_word(uint16_t envelope, uint32_t index) {
+    uint32_t word = multiphase_words[(envelope < 2 * ENVELOPE_UNITY ? envelope
+                                                                    : 2 * ENVELOPE_UNITY) >> 5];
+    return (index & 1) ? word + (word & (1u << 10)) : word;
+}
+
+// C-QUAM timing words for am_carrier, one per carrier cycle of
+// 2 * oversampling PIO cycles (high count + low count + 7). The pulse is
+// high for count + 2 cycles from the word's third; as with the multi-phase
+// carrier its width is the arcsine of the amplitude, so full envelope is a
+// 50% square.
+static void design_cqam(uint32_t oversampling, uint32_t sample_rate) {
+    cqam_period = 2 * oversampling;
+    for (int i = 0; i <= 256; i++) {
+        int32_t high = lroundf(cqam_period * asinf(i / 256.0f) / M_PI) - 2;
+        if (high < 0) high = 0;
+        cqam_high_counts[i] = high;
+    }
+    
+    cqam = (cqam_state_t){0};
+    cqam_pilot_phase = 0;
+    cqam_pilot_step = (uint32_t)(((uint64_t)CQAM_PILOT_HZ << 32) / sample_rate);
+}
+
+// Core 1: one carrier cycle whose edges move by the phase step since the
+// last word. Phase is carrier phase, cos(wt + phase): a positive step
+// advances the carrier, so its edges come earlier and this cycle is
+// shorter by step / 65536 of a period. The pulse starts at a fixed point
+// in its word, so a change of width also moves the word boundary back by
+// half of it, keeping the pulse centre (the phase a receiver sees) off the
+// envelope; only this word's own change is left, paid back in the next.
+// Fractions of a PIO cycle, and any
+// time a short cycle could not give up, carry to the next word; the edge
+// is rounded with the summed error added, so it dithers between whole
+// cycles and the phase is exact on average, not just to within a cycle.
+static inline uint32_t cqam_word(cqam_state_t* state, uint16_t envelope, int16_t phase) {
+    int32_t step = (int16_t)(phase - state->phase);
+    state->phase = phase;
+    
+    int32_t high = cqam_high_counts[(envelope < 2 * ENVELOPE_UNITY ? envelope
+                                                                   : 2 * ENVELOPE_UNITY) >> 5];
+    int32_t period = (int32_t)(cqam_period << 16) - step * (int32_t)cqam_period -
+                     ((high - state->high) << 15) + state->edge_error;
+    state->high = high;
+    int32_t low = ((period + state->edge_error_sum + 0x8000) >> 16) - 7 - high;
+    if (low < 0) low = 0;
+    state->edge_error = period - ((high + low + 7) << 16);
+    state->edge_error_sum += state->edge_error;
+    
+    return ((uint32_t)high << 16) | (uint32_t)low;
+}
+
+// Fine PWM words for fine_pwm, one per carrier cycle of 2 * oversampling
+// PIO cycles: [31:22] lead, [21:11] width, [10:0] trail, taking
+// lead + width + trail + 7 cycles (+ 6 with no pulse). A pulse of w cycles
+// has a fundamental of sin(pi * w / T), so w is the arcsine of the
+// amplitude (envelope / 2 * unity), full envelope a 50% square.
+static void design_fine_pwm(uint32_t oversampling) {
+    fine_pwm_period = 2 * oversampling;
+    for (int i = 0; i <= 256; i++) {
+        fine_pwm_widths[i] = lroundf(fine_pwm_period * asinf(i / 256.0f) / M_PI * 256);
+    }
+    for (uint32_t w = 0; w <= oversampling; w++) {
+        fine_pwm_levels[w] = lroundf(32768 * sinf(M_PI * w / fine_pwm_period));
+    }
+    fine_pwm = (fine_pwm_state_t){0};
+}
+
+// Core 1: one carrier cycle. A whole PIO cycle of width is a coarse step
+// (17 widths at 16x), so the width error is shaped out of the audio band,
+// (1 - z^-1)^2 like the sigma-delta modulator's, and the envelope detector
+// averages the widths back to ~14 bits. With --no-noise-shaping the width
+// is just rounded. The pulse stays centred in the cycle so width changes
+// do not phase-modulate the carrier.
+static inline uint32_t fine_pwm_word(fine_pwm_state_t* state, uint16_t envelope) {
+    const int32_t half = fine_pwm_period / 2;
+    
+    int32_t wanted = (envelope < 2 * ENVELOPE_UNITY ? envelope : 2 * ENVELOPE_UNITY) << 2;
+    if (config.noise_shaping) wanted += state->error[1] - 2 * state->error[0];
+    int32_t v = wanted < 0 ? 0 : wanted > 32768 ? 32768 : wanted;
+    
+    uint32_t index = v >> 7;
+    int32_t width = fine_pwm_widths[index];
+    if (index < 256) width += ((fine_pwm_widths[index + 1] - width) * (v & 127)) >> 7;
+    width = (width + 128) >> 8;
+    if (width > half) width = half;
+    
+    // Clipping at the ends must not wind the loop up
+    int32_t error = fine_pwm_levels[width] - wanted;
+    if (error > 8192) error = 8192;
+    if (error < -8192) error = -8192;
+    state->error[1] = state->error[0];
+    state->error[0] = error;
+    
+    // Pulse starts 5 cycles after the lead; an odd width's extra cycle
+    // goes first and last in turn
+    state->parity ^= 1;
+    int32_t lead = half - 5 - ((width + (int32_t)state->parity) >> 1);
+    int32_t trail = (int32_t)fine_pwm_period - 7 - width - lead + (width == 0);
+    return ((uint32_t)lead << 22) | ((uint32_t)width << 11) | (uint32_t)trail;
+}
+
 // ============================================================================
 // PIO AND HARDWARE SETUP
 // ============================================================================
 
+// Clock plan in force (persisted with the configuration)
+static clock_plan_t clock_plan;
+static bool clock_plan_restored = false;
+
+static uint8_t vreg_voltage_set = VREG_VOLTAGE_DEFAULT;
+
+static void set_core_voltage(uint8_t voltage) {
+    if (voltage == vreg_voltage_set) return;
+    vreg_set_voltage((enum vreg_voltage)voltage);
+    sleep_ms(OVERCLOCK_VREG_SETTLE_MS);
+    vreg_voltage_set = voltage;
+}
+
+// Code runs from XIP flash, whose SCK is clk_sys divided by the SSI
+// divider boot2 left behind (PICO_FLASH_SPI_CLKDIV, 2 by default)
+static bool flash_clock_ok(uint32_t sys_hz) {
+#if PICO_ON_DEVICE
+    uint32_t clkdiv = ssi_hw->baudr;
+    return clkdiv != 0 && sys_hz / clkdiv <= OVERCLOCK_FLASH_MAX_HZ;
+#else
+    (void)sys_hz;
+    return true;
+#endif
+}
+
+// Move clk_sys to the plan's PLL setting. The PIO divider is then derived
+// from the new clock by pio_divider_for() and comes out as planned. The
+// core voltage goes up before a faster clock and down after a slower one.
+static void apply_clock_plan(const clock_plan_t* plan) {
+    uint32_t current_hz = clock_get_hz(clk_sys);
+    
+    if (plan->sys_hz >= current_hz) set_core_voltage(plan->vreg_voltage);
+    if (plan->sys_hz != current_hz) {
+        set_sys_clock_pll(plan->vco_hz, plan->postdiv1, plan->postdiv2);
+    }
+    if (plan->sys_hz < current_hz) set_core_voltage(plan->vreg_voltage);
+    
+    if (config.verbose_analysis) {
+        printf("Clock plan: clk_sys %.3f MHz (VCO %d MHz / %d / %d), PIO divider %d + %d/256, "
+               "carrier error %.3f Hz\n", plan->sys_hz / 1e6f, plan->vco_hz / 1000000,
+               plan->postdiv1, plan->postdiv2, plan->div_int, plan->div_frac,
+               plan->error_mhz / 1000.0f);
+    }
+}
+
+// PIO program each configuration runs on (the DAC width is in the opcode)
+static const pio_program_t* pio_program_for(const transmitter_config_t* cfg) {
+    switch (cfg->signal_mode) {
+        case SIGNAL_MODE_SIGMA_DELTA: return &sigma_delta_bitstream_program;
+        case SIGNAL_MODE_OVERSAMPLED: return &advanced_am_carrier_program;
+        case SIGNAL_MODE_PARALLEL_DAC:
+        case SIGNAL_MODE_MULTICARRIER:
+            return cfg->dac_bits == 4 ? &parallel_dac_4_program :
+                   cfg->dac_bits == 6 ? &parallel_dac_6_program : &parallel_dac_8_program;
+        case SIGNAL_MODE_MULTIPHASE:  return &multiphase_carrier_program;
+        case SIGNAL_MODE_FINE_PWM:    return &fine_pwm_program;
+        default:                      return &am_carrier_program;
+    }
+}
+
+// PIO cycles spent on one FIFO word. Timing words: the fixed instructions
+// plus both countdown loops (high + 1 and low + 1, PIO_TIMING_LEVELS
+// counts from convert_to_pio_timing). Packed words: one cycle per sample. Multi-phase
+// words: half a carrier cycle; C-QUAM and fine PWM words: a whole one.
+static uint32_t pio_cycles_per_word(const transmitter_config_t* cfg) {
+    const pio_program_t* program = pio_program_for(cfg);
+    if (samples_per_word(cfg) > 1) return samples_per_word(cfg);
+    if (program == &multiphase_carrier_program) return cfg->oversampling_rate;
+    if (cfg->signal_mode == SIGNAL_MODE_CQAM || program == &fine_pwm_program) {
+        return 2 * cfg->oversampling_rate;
+    }
+    return (program == &advanced_am_carrier_program ? 7 : 5) + PIO_TIMING_LEVELS + 2;
+}
+
+// PIO clock divider for a carrier, 16.8 fixed point
+static uint32_t pio_divider_for(uint32_t carrier) {
+    uint64_t pio_hz = (uint64_t)carrier * config.oversampling_rate * 2;
+    return (uint32_t)(((uint64_t)clock_get_hz(clk_sys) * 256 + pio_hz / 2) / pio_hz);
+}
+
+static uint32_t phase_increment_for(uint32_t carrier) {
+    const uint32_t lut_size = sizeof(waveform_lut) / sizeof(waveform_lut[0]);
+    return (uint64_t)carrier * lut_size * 
+           (1ULL << 32) / (config.audio_sample_rate * config.oversampling_rate);
+}
+
+// Noise-transfer zeros at the NCO frequency: 1 - 2cos(w0) z^-1 + z^-2
+static int32_t requantiser_feedback(uint32_t increment) {
+    return (int32_t)lroundf(2.0f * cosf(2.0f * M_PI * (increment / 4294967296.0f)) * 16384);
+}
+
 void setup_pio_transmitter() {
+    static const pio_program_t* loaded_program = NULL;
+    static uint loaded_offset;
     pio = pio0;
     
-    // Choose PIO program based on signal mode
-    uint offset;
-    if (config.signal_mode == SIGNAL_MODE_OVERSAMPLED || 
-        config.signal_mode == SIGNAL_MODE_SIGMA_DELTA) {
-        offset = pio_add_program(pio, &advanced_am_carrier_program);
-    } else {
-        offset = pio_add_program(pio, &am_carrier_program);
+    // Called again between transmissions: release the previous program
+    if (loaded_program) {
+        pio_sm_set_enabled(pio, sm, false);
+        if (loaded_program == &multiphase_carrier_program) {
+            for (int k = 0; k < MULTIPHASE_PHASES - 1; k++) {
+                pio_sm_set_enabled(pio, lead_sms[k], false);
+                pio_sm_unclaim(pio, lead_sms[k]);
+            }
+        }
+        pio_remove_program(pio, loaded_program, loaded_offset);
+        pio_sm_unclaim(pio, sm);
     }
     
+    // Choose PIO program based on signal mode
+    loaded_program = pio_program_for(&config);
+    uint offset = pio_add_program(pio, loaded_program);
+    loaded_offset = offset;
+    
     sm = pio_claim_unused_sm(pio, true);
     
-    pio_sm_config pio_config = am_carrier_program_get_default_config(offset);
+    // Each program's own wrap settings
+    pio_sm_config pio_config;
+    uint base_pin = RF_OUTPUT_PIN;
+    uint pin_count = 1;
+    if (loaded_program == &sigma_delta_bitstream_program) {
+        pio_config = sigma_delta_bitstream_program_get_default_config(offset);
+    } else if (loaded_program == &advanced_am_carrier_program) {
+        pio_config = advanced_am_carrier_program_get_default_config(offset);
+    } else if (config.signal_mode == SIGNAL_MODE_PARALLEL_DAC ||
+               config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+        pio_config = parallel_dac_8_program_get_default_config(offset);  // All: one-instruction wrap
+        base_pin = DAC_OUTPUT_BASE_PIN;
+        pin_count = config.dac_bits;
+    } else if (loaded_program == &multiphase_carrier_program) {
+        pio_config = multiphase_carrier_program_get_default_config(offset);
+        base_pin = MULTIPHASE_OUTPUT_BASE_PIN + 2 * (MULTIPHASE_PHASES - 1);  // Last phase
+        pin_count = 2;
+        sm_config_set_sideset_pins(&pio_config, base_pin);  // Ends the pulse
+    } else if (loaded_program == &fine_pwm_program) {
+        pio_config = fine_pwm_program_get_default_config(offset);
+        sm_config_set_sideset_pins(&pio_config, base_pin);  // The pulse is side-set
+    } else {
+        pio_config = am_carrier_program_get_default_config(offset);
+    }
     
     // Configure output pins
-    uint pin_count = (config.signal_mode == SIGNAL_MODE_SIGMA_DELTA) ? 4 : 1;
-    sm_config_set_out_pins(&pio_config, RF_OUTPUT_PIN, pin_count);
-    sm_config_set_set_pins(&pio_config, RF_OUTPUT_PIN, pin_count);
+    sm_config_set_out_pins(&pio_config, base_pin, pin_count);
+    sm_config_set_set_pins(&pio_config, base_pin, pin_count < 5 ? pin_count : 5);  // SET reaches 5 pins
     
     // Calculate clock divider
-    float div = (float)clock_get_hz(clk_sys) / 
-                (config.carrier_frequency * config.oversampling_rate * 2.0f);
-    sm_config_set_clkdiv(&pio_config, div);
+    uint32_t div = pio_divider_for(config.carrier_frequency);
+    sm_config_set_clkdiv_int_frac(&pio_config, div >> 8, div & 0xFF);
     
-    sm_config_set_out_shift(&pio_config, false, true, 32);
+    // Shift left with autopull: MSB first, which the packed modes rely on.
+    // DAC words refill after their last whole sample (30 bits for 6-bit).
+    uint32_t packed_bits = 32;
+    if (config.signal_mode == SIGNAL_MODE_PARALLEL_DAC ||
+        config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+        packed_bits = samples_per_word(&config) * config.dac_bits;
+    }
+    bool multiphase = loaded_program == &multiphase_carrier_program;
+    sm_config_set_out_shift(&pio_config, false, true, packed_bits);
     sm_config_set_fifo_join(&pio_config, PIO_FIFO_JOIN_TX);
     
     // Initialize GPIO pins
-    for (uint pin = RF_OUTPUT_PIN; pin < RF_OUTPUT_PIN + pin_count; pin++) {
+    for (uint pin = base_pin; pin < base_pin + pin_count; pin++) {
         pio_gpio_init(pio, pin);
         pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
     }
     
     pio_sm_init(pio, sm, offset, &pio_config);
-    pio_sm_set_enabled(pio, sm, true);
+    
+    if (multiphase) {
+        // Leading phases on the lower pin pairs, same program and divider.
+        // Each starts with a delay word, k * T/8 for phase k; all phases
+        // are enabled together once DMA has filled their FIFOs.
+        for (int k = 0; k < MULTIPHASE_PHASES - 1; k++) {
+            uint lead_pin = MULTIPHASE_OUTPUT_BASE_PIN + 2 * k;
+            lead_sms[k] = pio_claim_unused_sm(pio, true);
+            sm_config_set_out_pins(&pio_config, lead_pin, 2);
+            sm_config_set_set_pins(&pio_config, lead_pin, 2);
+            sm_config_set_sideset_pins(&pio_config, lead_pin);
+            for (uint pin = lead_pin; pin < lead_pin + 2; pin++) {
+                pio_gpio_init(pio, pin);
+                pio_sm_set_consecutive_pindirs(pio, lead_sms[k], pin, 1, true);
+            }
+            pio_sm_init(pio, lead_sms[k], offset, &pio_config);
+            pio_sm_put(pio, lead_sms[k], k * config.oversampling_rate / 4);
+        }
+        pio_sm_put(pio, sm, (MULTIPHASE_PHASES - 1) * config.oversampling_rate / 4);
+    } else {
+        pio_sm_set_enabled(pio, sm, true);
+    }
     
     // Calculate phase increment
-    const uint32_t lut_size = sizeof(waveform_lut) / sizeof(waveform_lut[0]);
-    phase_increment = (uint64_t)config.carrier_frequency * lut_size * 
-                     (1ULL << 32) / (config.audio_sample_rate * config.oversampling_rate);
+    phase_increment = phase_increment_for(config.carrier_frequency);
+    requantiser.feedback = requantiser_feedback(phase_increment);
+    requantiser.error[0] = requantiser.error[1] = 0;
     
     if (config.verbose_analysis) {
         printf("PIO transmitter configured:\n");
-        printf("- Output pins: %d (starting at GPIO %d)\n", pin_count, RF_OUTPUT_PIN);
-        printf("- Clock divider: %.3f\n", div);
+        if (multiphase) {
+            printf("- Output pins: %d phases x 2 (GPIO %d-%d)\n", MULTIPHASE_PHASES,
+                   MULTIPHASE_OUTPUT_BASE_PIN, base_pin + 1);
+        } else {
+            printf("- Output pins: %d (starting at GPIO %d)\n", pin_count, base_pin);
+        }
+        printf("- Clock divider: %.3f\n", div / 256.0f);
         printf("- Phase increment: 0x%08X\n", phase_increment);
     }
 }
 
 // ============================================================================
-// EDUCATIONAL ANALYSIS AND MONITORING
+// TELEMETRY LOG RING
 // ============================================================================
+//
+// Producers copy a 20-byte record and bump their ring's head: a bounded
+// handful of cycles with no locks and no I/O. Interrupts are masked only
+// around the copy, because a core's IRQ handlers share its ring.
 
-void analyze_signal_quality() {
-    if (!config.verbose_analysis && !config.harmonic_analysis) return;
-    
-    printf("\nSignal Quality Analysis:\n");
-    printf("=======================\n");
-    
-    const char* mode_names[] = {
-        "Simple High Quality", "Basic Square Wave", "Sigma-Delta",
-        "Pure Sine Wave", "Pre-distortion", "Oversampled"
-    };
+static void log_push(log_event_t event, uint32_t a0, uint32_t a1, uint32_t a2) {
+    uint core = get_core_num();
+    telemetry_ring_t* ring = &telemetry_rings[core];
+    uint32_t irq_state = save_and_disable_interrupts();
     
-    printf("Signal Mode: %s\n", mode_names[config.signal_mode]);
-    printf("Carrier Frequency: %.1f kHz\n", config.carrier_frequency / 1000.0f);
-    printf("Modulation Depth: %d%%\n", config.modulation_depth);
+    uint32_t head = ring->head;
+    if (head - ring->tail >= TELEMETRY_RING_SIZE) {
+        ring->dropped++;
+    } else {
+        log_record_t* record = &ring->records[head & (TELEMETRY_RING_SIZE - 1)];
+        record->timestamp_us = time_us_32();
+        record->event = event;
+        record->core = core;
+        record->args[0] = a0;
+        record->args[1] = a1;
+        record->args[2] = a2;
+        __dmb();  // Record contents land before the new head
+        ring->head = head + 1;
+    }
+    restore_interrupts(irq_state);
+}
+
+static void log_format(const log_record_t* record) {
+    const uint32_t* args = record->args;
     
-    // Estimated performance based on mode
-    switch (config.signal_mode) {
-        case SIGNAL_MODE_SIMPLE:
-        case SIGNAL_MODE_SINE_WAVE:
-            measured_thd = 0.1f;
-            harmonic_levels[1] = -65; harmonic_levels[2] = -72; harmonic_levels[4] = -78;
+    switch (record->event) {
+        case LOG_CORE1_START:
+            printf("Core 1: Starting real-time signal processing\n");
             break;
-        case SIGNAL_MODE_SQUARE:
-            measured_thd = 10.5f;
-            harmonic_levels[1] = -9.5f; harmonic_levels[2] = -19.1f; harmonic_levels[4] = -27.9f;
+        case LOG_CORE1_STOP:
+            printf("Core 1: Signal processing stopped\n");
             break;
-        case SIGNAL_MODE_SIGMA_DELTA:
-            measured_thd = 0.8f;
-            harmonic_levels[1] = -45; harmonic_levels[2] = -52; harmonic_levels[4] = -58;
+        case LOG_STATUS:
+            printf("Transmission Status: %d seconds, %d samples processed, %d underruns\n",
+                   args[0], args[1], args[2]);
+            if (config.spectrum_analysis) {
+                printf("Spectrum: Fundamental=0dBc, 2nd=%.1fdBc, 3rd=%.1fdBc\n",
+                       harmonic_levels[1], harmonic_levels[2]);
+            }
             break;
-        case SIGNAL_MODE_PREDISTORTION:
-            measured_thd = 0.05f;
-            harmonic_levels[1] = -70; harmonic_levels[2] = -75; harmonic_levels[4] = -80;
+        case LOG_TIME_LIMIT:
+            printf("\nSafety time limit reached (%d seconds). Stopping transmission.\n",
+                   args[0]);
             break;
-        case SIGNAL_MODE_OVERSAMPLED:
-            measured_thd = 0.01f;
-            harmonic_levels[1] = -85; harmonic_levels[2] = -92; harmonic_levels[4] = -98;
+        case LOG_STAGE_PROFILE:
+#if STAGE_PROFILING
+            report_stage_profile(stage_profile_snapshot);
+#endif
+            break;
+        case LOG_GOVERNOR:
+            printf("DSP governor: %s -> %s (load %d%%)\n", quality_ladder[args[0]].name,
+                   quality_ladder[args[1]].name, args[2]);
+            break;
+        case LOG_RETUNE:
+            printf("Retuned %.1f -> %.1f kHz (PIO divider %.3f), depth %d%%\n",
+                   args[0] / 1000.0f, args[1] / 1000.0f, args[2] / 256.0f,
+                   config.modulation_depth);
+            break;
+        case LOG_FIRST_RF:
+            printf("Carrier up %.1f ms after boot\n", args[0] / 1000.0f);
+            break;
+        case LOG_UNDERRUN:
+            if (config.verbose_analysis) {
+                printf("Underrun %d at +%d ms (buffer %d not ready), holding carrier\n",
+                       args[0], (record->timestamp_us - (uint32_t)pipeline_start_us) / 1000,
+                       args[1]);
+            }
             break;
     }
-    
-    printf("Estimated THD: %.3f%%\n", measured_thd);
-    if (config.harmonic_analysis) {
-        printf("Harmonic Levels:\n");
-        printf("- 2nd: %.1f dBc\n", harmonic_levels[1]);
-        printf("- 3rd: %.1f dBc\n", harmonic_levels[2]);
-        printf("- 5th: %.1f dBc\n", harmonic_levels[4]);
-    }
-    
-    if (config.filter_mode != FILTER_MODE_NONE) {
-        const char* filter_names[] = {
-            "None", "Low-pass", "IIR Butterworth", "FIR Windowed", "Elliptic", "Multi-band"
-        };
-        printf("Filter: %s\n", filter_names[config.filter_mode]);
-        printf("Filter Bandwidth: %.1f Hz\n", config.filter_bandwidth);
-    }
-    
-    printf("=======================\n");
 }
 
-void monitor_transmission() {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    uint32_t elapsed_seconds = (current_time - transmission_start_time) / 1000;
-    
-    if (config.verbose_analysis && (elapsed_seconds % 30 == 0)) {
-        printf("Transmission Status: %d seconds, %d samples processed\n", 
-               elapsed_seconds, samples_processed);
+// Core 0 only: format and print everything queued so far
+static void telemetry_drain() {
+    for (int core = 0; core < 2; core++) {
+        telemetry_ring_t* ring = &telemetry_rings[core];
         
-        if (config.spectrum_analysis) {
-            printf("Spectrum: Fundamental=0dBc, 2nd=%.1fdBc, 3rd=%.1fdBc\n",
-                   harmonic_levels[1], harmonic_levels[2]);
+        while (ring->tail != ring->head) {
+            __dmb();  // Head observed before reading the record
+            log_format(&ring->records[ring->tail & (TELEMETRY_RING_SIZE - 1)]);
+            ring->tail = ring->tail + 1;
+        }
+        
+        if (ring->dropped) {
+            printf("Telemetry: %d records dropped on core %d\n", ring->dropped, core);
+            ring->dropped = 0;
         }
-    }
-    
-    // Safety time limit check
-    if (config.enable_safety_limits && elapsed_seconds >= config.transmission_time_limit) {
-        printf("\nSafety time limit reached (%d seconds). Stopping transmission.\n",
-               config.transmission_time_limit);
-        transmission_active = false;
     }
 }
 
 // ============================================================================
-// WAV FILE PROCESSING
+// STAGE PROFILING
 // ============================================================================
+//
+// Probes bracket each stage and accumulate its cost over a block; one sample
+// per stage per block feeds min/mean/max and a log2 histogram. Per-sample
+// stages on core 1 are timed with laps, so the probe cost is included.
 
-bool read_wav_header(FIL* file, wav_header_t* header) {
-    UINT bytes_read;
-    FRESULT fr = f_read(file, header, sizeof(wav_header_t), &bytes_read);
-    
-    if (fr != FR_OK || bytes_read != sizeof(wav_header_t)) {
-        printf("Error: Failed to read WAV header (error: %d)\n", fr);
-        return false;
-    }
-    
+#if STAGE_PROFILING
+
+#define STAGE_CLOCK_MASK 0xFFFFFF       // SysTick is a 24-bit down counter
+
+#if PICO_ON_DEVICE
+#define STAGE_CLOCK_UNITS "cycles"
+
+// Each core has its own SysTick; run it free at the processor clock
+static void stage_clock_init() {
+    systick_hw->rvr = STAGE_CLOCK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;  // ENABLE | CLKSOURCE (processor clock)
+}
+
+static inline uint32_t stage_clock() {
+    return (0 - systick_hw->cvr) & STAGE_CLOCK_MASK;  // Counts up
+}
+#else
+#define STAGE_CLOCK_UNITS "ns"
+
+static void stage_clock_init() {
+}
+
+static inline uint32_t stage_clock() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec) & STAGE_CLOCK_MASK;
+}
+#endif
+
+static inline uint32_t stage_elapsed(uint32_t since) {
+    return (stage_clock() - since) & STAGE_CLOCK_MASK;
+}
+
+static void stage_record(profile_stage_t stage, uint32_t cost) {
+    stage_stats_t* stats = &stage_stats[stage];
+    uint32_t bin = cost ? 32 - __builtin_clz(cost) : 0;
+    if (bin >= STAGE_HISTOGRAM_BINS) bin = STAGE_HISTOGRAM_BINS - 1;
+    
+    if (stats->count == 0 || cost < stats->min) stats->min = cost;
+    if (cost > stats->max) stats->max = cost;
+    stats->count++;
+    stats->total += cost;
+    stats->bins[bin]++;
+}
+
+static void stage_stats_print(const stage_stats_t* stats, profile_stage_t first,
+                              profile_stage_t last) {
+    static const char* const stage_names[STAGE_COUNT] = {
+        "decode", "resample", "modulate", "filter", "pio format", "dma queue"
+    };
+    
+    for (int stage = first; stage <= last; stage++) {
+        const stage_stats_t* st = &stats[stage];
+        if (st->count == 0) continue;
+        
+        printf("- %s: %d blocks, min %d, mean %.0f, max %d\n  ", stage_names[stage],
+               st->count, st->min, (double)st->total / st->count, st->max);
+        for (int b = 0; b < STAGE_HISTOGRAM_BINS; b++) {
+            if (st->bins[b]) printf("[<2^%d]=%d ", b, st->bins[b]);
+        }
+        printf("\n");
+    }
+}
+
+// Core 0: ask core 1 to publish its stages at the next block boundary
+void stage_profile_request() {
+    stage_profile_requested = true;
+}
+
+// Core 1: copy stage stats for core 0 and queue the dump
+static void stage_profile_publish() {
+    memcpy(&stage_profile_snapshot[STAGE_MODULATE], &stage_stats[STAGE_MODULATE],
+           sizeof(stage_stats_t) * (STAGE_COUNT - STAGE_MODULATE));
+    stage_profile_requested = false;
+    log_push(LOG_STAGE_PROFILE, 0, 0, 0);
+}
+
+// Core 0: stage costs per block (units depend on the build)
+void report_stage_profile(const stage_stats_t* core1_stats) {
+    printf("Stage profile (" STAGE_CLOCK_UNITS " per block):\n");
+    stage_stats_print(stage_stats, STAGE_DECODE, STAGE_RESAMPLE);
+    stage_stats_print(core1_stats, STAGE_MODULATE, STAGE_DMA_QUEUE);
+}
+
+#define PROFILE_START(var) uint32_t var = stage_clock()
+#define PROFILE_END(stage, var) stage_record(stage, stage_elapsed(var))
+#define PROFILE_BLOCK_BEGIN() uint32_t profile_cost[STAGE_COUNT] = {0}; uint32_t profile_mark
+#define PROFILE_MARK() (profile_mark = stage_clock())
+#define PROFILE_LAP(stage) do { \
+        uint32_t profile_now = stage_clock(); \
+        profile_cost[stage] += (profile_now - profile_mark) & STAGE_CLOCK_MASK; \
+        profile_mark = profile_now; \
+    } while (0)
+#define PROFILE_COMMIT(stage) stage_record(stage, profile_cost[stage])
+
+#else
+
+#define PROFILE_START(var) do {} while (0)
+#define PROFILE_END(stage, var) do {} while (0)
+#define PROFILE_BLOCK_BEGIN() do {} while (0)
+#define PROFILE_MARK() do {} while (0)
+#define PROFILE_LAP(stage) do {} while (0)
+#define PROFILE_COMMIT(stage) do {} while (0)
+
+#endif
+
+// ============================================================================
+// EVENT-DRIVEN PIPELINE SCHEDULING
+// ============================================================================
+//
+// Nothing in the pipeline polls on a timer. Waiting cores sleep in __wfe()
+// and are woken by __sev() from the other core or by the DMA completion
+// IRQ; every loop re-checks its condition, so spurious wakes are harmless.
+
+static inline void signal_event(wake_event_t event) {
+    wake_signal_time[event] = time_us_32();
+    __sev();
+}
+
+// Called by a core that slept: record signal -> resume latency
+static void record_wake_latency(wake_event_t event) {
+    uint32_t latency = time_us_32() - wake_signal_time[event];
+    wake_latency_t* stats = &wake_latency[event];
+    uint32_t bin = latency ? 32 - __builtin_clz(latency) : 0;
+    if (bin >= WAKE_HISTOGRAM_BINS) bin = WAKE_HISTOGRAM_BINS - 1;
+    
+    stats->count++;
+    stats->total_us += latency;
+    if (latency > stats->max_us) stats->max_us = latency;
+    stats->bins[bin]++;
+}
+
+// Every phase of the multi-phase carrier plays the same words. The leading
+// phases drain first, so their channels are idle when the last one's IRQ
+// restarts them all.
+static void dma_play_words(const uint32_t* words, uint32_t count) {
+    for (uint k = 0; k < lead_dma_count; k++) {
+        dma_channel_set_read_addr(lead_dma_chans[k], words, false);
+        dma_channel_set_trans_count(lead_dma_chans[k], count, true);
+    }
+    dma_channel_set_read_addr(dma_chan, words, false);
+    dma_channel_set_trans_count(dma_chan, count, true);
+}
+
+static void start_modulation_dma(int buffer) {
+    dma_active_buffer = buffer;
+    dma_start_us = time_us_32();
+    if (buffer == DMA_CARRIER_HOLD) {
+        dma_play_words(carrier_hold_buffer, carrier_hold_words);
+    } else {
+        // First buffer formatted for a new carrier: switch the PIO clock
+        // as DMA starts it, without restarting the divider or flushing the
+        // FIFO. The joined TX FIFO still holds up to 8 words of the old
+        // buffer (and the state machine is part way through another), so
+        // those play at the new divider: the switch lands up to
+        // 8 * pio_cycles_per_word() PIO cycles early, time-scaling that
+        // stretch by the frequency ratio. Multi-phase dividers restart
+        // together to keep the phases locked.
+        uint32_t div = buffer_pio_divider[buffer];
+        if (div) {
+            pio_sm_set_clkdiv_int_frac(pio, sm, div >> 8, div & 0xFF);
+            if (lead_dma_count) {
+                uint32_t mask = 1u << sm;
+                for (uint k = 0; k < lead_dma_count; k++) {
+                    pio_sm_set_clkdiv_int_frac(pio, lead_sms[k], div >> 8, div & 0xFF);
+                    mask |= 1u << lead_sms[k];
+                }
+                pio_clkdiv_restart_sm_mask(pio, mask);
+            }
+            buffer_pio_divider[buffer] = 0;
+        }
+        dma_play_words(modulation_buffers[buffer], BUFFER_SIZE);
+    }
+}
+
+// Convert amplitude to PIO timing
+uint32_t convert_to_pio_timing(uint32_t amplitude) {
+    uint32_t base_period = PIO_TIMING_LEVELS;  // Base timing period
+    uint32_t high_time = (amplitude * base_period) / 4096;
+    uint32_t low_time = base_period - high_time;
+    
+    if (high_time < 1) high_time = 1;
+    if (low_time < 1) low_time = 1;
+    
+    return (high_time << 16) | low_time;
+}
+
+// Core 1 (RF rate): 12-bit amplitude to a timing word, like
+// convert_to_pio_timing() but dithered and noise shaped. Truncating to 64
+// levels leaves ~6 bits and spurs that track the signal; TPDF dither
+// decorrelates the error, and the feedback moves it away from the carrier.
+// The error stays within 1.5 LSB, so the feedback adds at most 4.5 LSB:
+// the amplitude is scaled into PIO_SHAPED_MARGIN .. 64 - PIO_SHAPED_MARGIN
+// levels, where a full-scale input never drives the loop into the ends.
+static inline int32_t shaped_pio_target(uint32_t amplitude) {
+    const int32_t lsb = 4096 / PIO_TIMING_LEVELS;
+    return PIO_SHAPED_MARGIN * lsb +
+           (((int32_t)amplitude * (PIO_TIMING_LEVELS - 2 * PIO_SHAPED_MARGIN)) >> 6);
+}
+
+static inline uint32_t shaped_pio_timing(requantiser_state_t* state, uint32_t amplitude) {
+    const int32_t lsb = 4096 / PIO_TIMING_LEVELS;
+    
+    // Sum of two uniform halves of one xorshift32 draw: triangular, +-1 LSB
+    uint32_t r = state->dither;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    state->dither = r;
+    int32_t tpdf = ((int32_t)(r & 0xFFFF) + (int32_t)(r >> 16) - 0xFFFF) >> 10;
+    
+    int32_t wanted = shaped_pio_target(amplitude) - ((state->feedback * state->error[0]) >> 14) +
+                     state->error[1];
+    int32_t high_time = (wanted + tpdf + lsb / 2) >> 6;  // Flooring divide by lsb
+    if (high_time < 1) high_time = 1;
+    if (high_time > PIO_TIMING_LEVELS - 1) high_time = PIO_TIMING_LEVELS - 1;
+    
+    // Clipping at the ends must not wind the loop up
+    int32_t error = high_time * lsb - wanted;
+    if (error > 2 * lsb) error = 2 * lsb;
+    if (error < -2 * lsb) error = -2 * lsb;
+    state->error[1] = state->error[0];
+    state->error[0] = error;
+    
+    return ((uint32_t)high_time << 16) | (PIO_TIMING_LEVELS - high_time);
+}
+
+// Fill the hold buffer with 50% duty words: one unmodulated carrier cycle
+// each. Packed modes hold the modulator's unmodulated carrier instead, cut
+// to a whole number of carrier cycles so the phase is continuous on replay.
+static void build_carrier_hold_buffer() {
+    uint32_t samples = samples_per_word(&config);
+    if (config.signal_mode == SIGNAL_MODE_MULTIPHASE) {
+        carrier_hold_words = CARRIER_HOLD_WORDS;  // Even: whole cycles
+        for (int i = 0; i < CARRIER_HOLD_WORDS; i++) {
+            carrier_hold_buffer[i] = multiphase_word(ENVELOPE_UNITY, i);
+        }
+        return;
+    }
+    if (config.signal_mode == SIGNAL_MODE_CQAM) {
+        cqam_state_t hold = {0};
+        carrier_hold_words = CARRIER_HOLD_WORDS;
+        for (int i = 0; i < CARRIER_HOLD_WORDS; i++) {
+            carrier_hold_buffer[i] = cqam_word(&hold, ENVELOPE_UNITY, 0);
+        }
+        return;
+    }
+    if (config.signal_mode == SIGNAL_MODE_FINE_PWM) {
+        fine_pwm_state_t hold = {0};
+        carrier_hold_words = CARRIER_HOLD_WORDS;
+        for (int i = 0; i < CARRIER_HOLD_WORDS; i++) {
+            carrier_hold_buffer[i] = fine_pwm_word(&hold, ENVELOPE_UNITY);
+        }
+        return;
+    }
+    if (config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+        // Every station unmodulated; only the main one is phase-continuous
+        // on replay, the others' frequencies do not divide the buffer
+        uint16_t unity[MULTICARRIER_MAX];
+        for (int k = 0; k < MULTICARRIER_MAX; k++) unity[k] = ENVELOPE_UNITY;
+        multicarrier_state_t hold = {0};
+        carrier_hold_words = CARRIER_HOLD_WORDS;
+        for (int i = 0; i < CARRIER_HOLD_WORDS; i++) {
+            carrier_hold_buffer[i] = multicarrier_word(&hold, unity, multicarrier_count);
+        }
+        return;
+    }
+    if (samples > 1) {
+        uint32_t samples_per_cycle = 2 * config.oversampling_rate;
+        uint32_t a = samples_per_cycle, b = samples;
+        while (b) { uint32_t t = a % b; a = b; b = t; }
+        uint32_t cycle_words = samples_per_cycle / a;
+        sigma_delta_state_t hold = {0};
+        
+        carrier_hold_words = CARRIER_HOLD_WORDS - CARRIER_HOLD_WORDS % cycle_words;
+        for (uint32_t i = 0; i < carrier_hold_words; i++) {
+            carrier_hold_buffer[i] = packed_word(&hold, ENVELOPE_UNITY);
+        }
+        return;
+    }
+    
+    carrier_hold_words = CARRIER_HOLD_WORDS;
+    uint32_t word = convert_to_pio_timing(2048);
+    for (int i = 0; i < CARRIER_HOLD_WORDS; i++) {
+        carrier_hold_buffer[i] = word;
+    }
+}
+
+// DMA_IRQ_1, registered from core 1 so it runs there
+static void modulation_dma_irq_handler() {
+    dma_channel_acknowledge_irq1(dma_chan);
+    
+    int finished = dma_active_buffer;
+    if (finished == 0 || finished == 1) {
+        modulation_buffer_full[finished] = false;
+        dma_last_buffer = finished;
+        dma_block_us = time_us_32() - dma_start_us;  // Real-time budget per block
+    }
+    
+    int next = dma_last_buffer ^ 1;
+    if (modulation_buffer_full[next]) {
+        start_modulation_dma(next);
+    } else {
+        // Starved: keep the carrier alive and record the event
+        if (finished == DMA_CARRIER_HOLD) {
+            hold_blocks_played++;
+        } else if (output_primed) {
+            uint64_t now = time_us_64();
+            underrun_log[underrun_count % UNDERRUN_LOG_SIZE] = now;
+            underrun_count++;
+            log_push(LOG_UNDERRUN, underrun_count, next, 0);
+        }
+        start_modulation_dma(DMA_CARRIER_HOLD);
+    }
+    signal_event(WAKE_CORE1_DMA_DONE);
+}
+
+void setup_modulation_dma() {
+    dma_chan = dma_claim_unused_channel(true);
+    
+    dma_channel_config dma_config = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    channel_config_set_dreq(&dma_config, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_chan, &dma_config, &pio->txf[sm], NULL, BUFFER_SIZE, false);
+    
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    irq_set_exclusive_handler(DMA_IRQ_1, modulation_dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_1, true);
+    
+    // Leading phases: same words into their own FIFOs, no interrupt
+    if (config.signal_mode == SIGNAL_MODE_MULTIPHASE) {
+        for (int k = 0; k < MULTIPHASE_PHASES - 1; k++) {
+            lead_dma_chans[k] = dma_claim_unused_channel(true);
+            channel_config_set_dreq(&dma_config, pio_get_dreq(pio, lead_sms[k], true));
+            dma_channel_configure(lead_dma_chans[k], &dma_config, &pio->txf[lead_sms[k]],
+                                  NULL, BUFFER_SIZE, false);
+        }
+        lead_dma_count = MULTIPHASE_PHASES - 1;
+    }
+    
+    modulation_buffer_full[0] = modulation_buffer_full[1] = false;
+    buffer_pio_divider[0] = buffer_pio_divider[1] = 0;
+    dma_last_buffer = 1;  // Core 1 fills buffer 0 first on every run
+    output_primed = false;
+    underrun_count = 0;
+    hold_blocks_played = 0;
+    
+    // Carrier comes up immediately and holds until the first audio block
+    build_carrier_hold_buffer();
+    start_modulation_dma(DMA_CARRIER_HOLD);
+    
+    // Multi-phase: start every phase on the same clock edge once all FIFOs
+    // are full, so none stalls and slips against the others
+    if (lead_dma_count) {
+        uint32_t mask = 1u << sm;
+        while (!pio_sm_is_tx_fifo_full(pio, sm)) tight_loop_contents();
+        for (int k = 0; k < MULTIPHASE_PHASES - 1; k++) {
+            while (!pio_sm_is_tx_fifo_full(pio, lead_sms[k])) tight_loop_contents();
+            mask |= 1u << lead_sms[k];
+        }
+        pio_enable_sm_mask_in_sync(pio, mask);
+    }
+    if (first_rf_us == 0) {
+        first_rf_us = time_us_64();
+        log_push(LOG_FIRST_RF, (uint32_t)first_rf_us, 0, 0);
+    }
+}
+
+// Hand a filled buffer to the DMA engine. The IRQ switches over from the
+// hold buffer at its next completion, so no DMA restart happens here.
+static void queue_modulation_buffer(int buffer) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    modulation_buffer_full[buffer] = true;
+    output_primed = true;
+    if (dma_active_buffer < 0) {
+        start_modulation_dma(buffer);
+    }
+    restore_interrupts(irq_state);
+}
+
+void report_underruns() {
+    printf("Output underruns: %d (carrier held for %d extra blocks of %d words)\n",
+           underrun_count, hold_blocks_played, CARRIER_HOLD_WORDS);
+    
+    uint32_t logged = underrun_count < UNDERRUN_LOG_SIZE ? underrun_count : UNDERRUN_LOG_SIZE;
+    for (uint32_t i = 0; i < logged; i++) {
+        uint32_t index = (underrun_count - logged + i) % UNDERRUN_LOG_SIZE;
+        uint64_t t = underrun_log[index] - pipeline_start_us;
+        printf("- +%llu.%03llu s\n", (unsigned long long)(t / 1000000),
+               (unsigned long long)((t / 1000) % 1000));
+    }
+}
+
+void stop_modulation_dma() {
+    irq_set_enabled(DMA_IRQ_1, false);
+    dma_channel_set_irq1_enabled(dma_chan, false);
+    dma_channel_abort(dma_chan);
+    dma_channel_unclaim(dma_chan);
+    for (uint k = 0; k < lead_dma_count; k++) {
+        dma_channel_abort(lead_dma_chans[k]);
+        dma_channel_unclaim(lead_dma_chans[k]);
+    }
+    lead_dma_count = 0;
+    dma_active_buffer = -1;
+}
+
+void report_wake_latency() {
+    static const char* const event_names[WAKE_EVENT_COUNT] = {
+        "Core 0 <- slot free", "Core 1 <- block ready", "Core 1 <- DMA done"
+    };
+    
+    printf("Wake-to-work latency (us, log2 buckets):\n");
+    for (int e = 0; e < WAKE_EVENT_COUNT; e++) {
+        const wake_latency_t* stats = &wake_latency[e];
+        if (stats->count == 0) continue;
+        
+        printf("- %s: %d wakes, avg %.1f, max %d\n  ", event_names[e], stats->count,
+               (float)stats->total_us / stats->count, stats->max_us);
+        for (int b = 0; b < WAKE_HISTOGRAM_BINS; b++) {
+            if (stats->bins[b]) printf("[<%d]=%d ", 1 << b, stats->bins[b]);
+        }
+        printf("\n");
+    }
+}
+
+// ============================================================================
+// DSP LOAD GOVERNOR
+// ============================================================================
+//
+// Core 1 compares each block's processing time (the busier of the two
+// cores) with the time the DMA takes to play a block. Sustained overload
+// steps down the quality ladder; a long run of headroom steps back up. A
+// step up that overloads again soon doubles the wait before the next try.
+
+typedef struct {
+    uint32_t level;               // Index into quality_ladder
+    uint32_t overload_blocks;
+    uint32_t relaxed_blocks;
+    uint32_t holdoff_blocks;      // Relaxed blocks required to step up
+    uint32_t blocks_since_up;
+    uint32_t last_underruns;
+    uint32_t load_pct;
+    uint32_t peak_load_pct;
+    uint32_t transitions;
+} load_governor_t;
+
+static load_governor_t governor = { .holdoff_blocks = GOVERNOR_STEP_UP_BLOCKS };
+
+// Core 1, between blocks: make a rung's settings live
+static void governor_apply(uint32_t level) {
+    const quality_rung_t* rung = &quality_ladder[level];
+    
+    active_iir_sections = num_filter_sections < rung->max_iir_sections ?
+                          num_filter_sections : rung->max_iir_sections;
+    
+    switch (rung->fir_tap_shift) {
+        case 0:
+            active_fir_coefficients = fir_coefficients;
+            active_fir_length = fir_length;
+            break;
+        case 1:
+            active_fir_coefficients = fir_coefficients + 256;
+            active_fir_length = fir_length >> 1;
+            break;
+        case 2:
+            active_fir_coefficients = fir_coefficients + 256 + 128;
+            active_fir_length = fir_length >> 2;
+            break;
+        default:
+            active_fir_length = 0;  // Bypass
+            break;
+    }
+    
+    active_predistortion = rung->predistortion;
+}
+
+static void governor_set_level(uint32_t level) {
+    log_push(LOG_GOVERNOR, governor.level, level, governor.load_pct);
+    governor.level = level;
+    governor.transitions++;
+    governor.overload_blocks = governor.relaxed_blocks = 0;
+    governor_apply(level);
+}
+
+// Core 1, once per block
+static void governor_update(uint32_t core1_busy_us) {
+    uint32_t budget = dma_block_us;
+    if (!config.enable_governor || budget == 0) return;
+    
+    uint32_t busy = core1_busy_us > core0_block_busy_us ? core1_busy_us : core0_block_busy_us;
+    governor.load_pct = busy * 100 / budget;
+    if (governor.load_pct > governor.peak_load_pct) governor.peak_load_pct = governor.load_pct;
+    governor.blocks_since_up++;
+    
+    bool underran = underrun_count != governor.last_underruns;
+    governor.last_underruns = underrun_count;
+    
+    if (underran || governor.load_pct >= GOVERNOR_OVERLOAD_PCT) {
+        governor.relaxed_blocks = 0;
+        governor.overload_blocks++;
+        
+        // An underrun already cost audio: degrade without waiting
+        if (governor.level + 1 < QUALITY_RUNGS &&
+            (underran || governor.overload_blocks >= GOVERNOR_STEP_DOWN_BLOCKS)) {
+            if (governor.blocks_since_up < governor.holdoff_blocks * 2 &&
+                governor.holdoff_blocks < GOVERNOR_MAX_HOLDOFF) {
+                governor.holdoff_blocks *= 2;  // Stepping up just failed
+            }
+            governor_set_level(governor.level + 1);
+        }
+    } else if (governor.load_pct < GOVERNOR_RELAX_PCT) {
+        governor.overload_blocks = 0;
+        governor.relaxed_blocks++;
+        
+        if (governor.level > 0 && governor.relaxed_blocks >= governor.holdoff_blocks) {
+            governor_set_level(governor.level - 1);
+            governor.blocks_since_up = 0;
+        }
+    } else {
+        governor.overload_blocks = governor.relaxed_blocks = 0;
+    }
+}
+
+void report_governor() {
+    printf("- DSP governor: %s, rung '%s', peak load %d%%, %d transitions\n",
+           config.enable_governor ? "on" : "off", quality_ladder[governor.level].name,
+           governor.peak_load_pct, governor.transitions);
+}
+
+// ============================================================================
+// IMA-ADPCM DECODER
+// ============================================================================
+
+static const int16_t ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t ima_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+// Number of sample frames held in a WAV IMA-ADPCM block of block_size bytes
+// (header sample + 8 frames per 4-byte group per channel)
+static inline uint32_t ima_adpcm_frames_per_block(uint32_t block_size, uint16_t channels) {
+    if (block_size < 4u * channels) return 0;
+    return 1 + ((block_size - 4u * channels) / (4u * channels)) * 8;
+}
+
+// Expand one 4-bit code, integer only. The difference is (magnitude + 1/2)
+// steps / 4 computed in one multiply, as ffmpeg's adpcm_ima_wav decoder
+// does; the IMA reference's shift-and-add form truncates each partial
+// step and lands up to 2 LSB low of what such encoders predicted.
+static inline int16_t ima_adpcm_expand_nibble(ima_adpcm_state_t* state, uint8_t nibble) {
+    int32_t step = ima_step_table[state->step_index];
+    int32_t diff = ((2 * (nibble & 7) + 1) * step) >> 3;
+    
+    int32_t predictor = state->predictor + ((nibble & 8) ? -diff : diff);
+    if (predictor > 32767) predictor = 32767;
+    if (predictor < -32768) predictor = -32768;
+    state->predictor = predictor;
+    
+    int32_t index = state->step_index + ima_index_table[nibble];
+    if (index < 0) index = 0;
+    if (index > 88) index = 88;
+    state->step_index = index;
+    
+    return (int16_t)predictor;
+}
+
+// Decode one WAV (Microsoft layout) IMA-ADPCM block into interleaved PCM.
+// Pure function with no hardware dependencies so it can be checked on a host
+// against a reference decoder. Returns the number of frames written.
+uint32_t ima_adpcm_decode_block(const uint8_t* block, uint32_t block_size,
+                                uint16_t channels, int16_t* output) {
+    ima_adpcm_state_t state[2];
+    const uint8_t* p = block;
+    uint32_t frames = ima_adpcm_frames_per_block(block_size, channels);
+    if (frames == 0) return 0;
+    
+    // Per-channel preamble: predictor (int16 LE), step index, reserved
+    for (uint16_t ch = 0; ch < channels; ch++) {
+        state[ch].predictor = (int16_t)(p[0] | (p[1] << 8));
+        state[ch].step_index = p[2] > 88 ? 88 : p[2];
+        output[ch] = (int16_t)state[ch].predictor;
+        p += 4;
+    }
+    
+    uint32_t frame = 1;
+    
+    // Body: each channel contributes 4 bytes (8 samples) in turn, low nibble first
+    while (frame < frames) {
+        for (uint16_t ch = 0; ch < channels; ch++) {
+            int16_t* out = &output[frame * channels + ch];
+            for (int i = 0; i < 4; i++) {
+                uint8_t byte = *p++;
+                out[(2 * i) * channels]     = ima_adpcm_expand_nibble(&state[ch], byte & 0x0F);
+                out[(2 * i + 1) * channels] = ima_adpcm_expand_nibble(&state[ch], byte >> 4);
+            }
+        }
+        frame += 8;
+    }
+    
+    return frames;
+}
+
+// ============================================================================
+// DSP THROUGHPUT SELF-TEST
+// ============================================================================
+//
+// Before each transmission, core 0 times core 1's RF-rate work (NCO,
+// biquads, PIO formatting) on the clock and rung about to be used. The PIO
+// consumes one word per pio_cycles_per_word() PIO cycles, so the cost per
+// word caps carrier * oversampling just as the PIO divider (>= 1) does.
+// Core 0's own audio-rate stage (envelope, C-QUAM CORDIC, SSB Hilbert) is
+// timed per sample alongside, into the idle first pipeline block, and so
+// is the IMA-ADPCM decoder that feeds it from compressed WAVs.
+
+static uint32_t selftest_cycles_per_word = 1;
+static uint32_t selftest_cycles_per_sample = 1;
+static uint32_t selftest_adpcm_cycles_per_sample = 1;
+
+// Multi-carrier word for `stations` stations at varying envelopes, on a
+// copy of the NCO state so the transmission starts where it would have
+static uint32_t multicarrier_selftest_word(uint32_t stations, uint32_t i) {
+    static multicarrier_state_t probe;
+    uint16_t envelopes[MULTICARRIER_MAX];
+    if (i == 0) probe = multicarrier;
+    for (uint32_t k = 0; k < MULTICARRIER_MAX; k++) {
+        envelopes[k] = ENVELOPE_UNITY / 2 + ((i + 256 * k) & 1023);
+    }
+    return multicarrier_word(&probe, envelopes, stations);
+}
+
+static uint32_t multicarrier_cycles_per_word(uint32_t stations) {
+    volatile uint32_t sink = 0;
+    uint64_t start = 0;
+    for (uint32_t i = 0; i < SELFTEST_WARMUP_WORDS + SELFTEST_WORDS; i++) {
+        if (i == SELFTEST_WARMUP_WORDS) start = time_us_64();
+        sink = multicarrier_selftest_word(stations, i);
+    }
+    (void)sink;
+    uint64_t cycles = (time_us_64() - start) * clock_get_hz(clk_sys) / 1000000;
+    return (uint32_t)((cycles + SELFTEST_WORDS - 1) / SELFTEST_WORDS);
+}
+
+// Stations the ladder sum sustains at this clock, carrier and oversampling:
+// cost per word grows linearly with the station count, measured at both ends
+static void report_multicarrier_capacity(uint32_t sys_hz) {
+    uint32_t one = multicarrier_cycles_per_word(1);
+    uint32_t all = multicarrier_cycles_per_word(MULTICARRIER_MAX);
+    uint32_t per_station = all > one ? (all - one) / (MULTICARRIER_MAX - 1) : 1;
+    if (per_station == 0) per_station = 1;
+    
+    uint64_t pio_hz = (uint64_t)config.carrier_frequency * config.oversampling_rate * 2;
+    uint64_t budget = (uint64_t)sys_hz * GOVERNOR_OVERLOAD_PCT / 100 *
+                      samples_per_word(&config) / pio_hz;
+    uint32_t sustainable = budget < one ? 0 : 1 + (uint32_t)((budget - one) / per_station);
+    
+    printf("Multi-carrier: %d cycles per word + %d per extra station, budget %d: "
+           "sustains %d station(s) (engine maximum %d, %d configured)\n",
+           one, per_station, (uint32_t)budget, sustainable, MULTICARRIER_MAX, multicarrier_count);
+    if (sustainable < multicarrier_count) {
+        printf("Warning: too many stations for this clock; lower --oversample or --dac-bits, "
+               "or use a faster --overclock profile\n");
+    }
+}
+
+// Fine PWM envelope resolution, on a model of fine_pwm.pio: each word is
+// timed as the program runs it, its pulse's fundamental taken, and the
+// result decimated through a sinc^3 (FINE_PWM_DECIMATION) like a
+// receiver's detector and IF filter. A tone at 80% depth is fitted out of
+// the output; the rest is noise and distortion. Returns effective bits;
+// words that miss the carrier period are counted in `timing_errors`.
+static float fine_pwm_effective_bits(bool shaped, uint32_t* timing_errors) {
+    enum { TONE = 64, OUTPUTS = 512, SETTLE = 4 };  // Outputs per tone cycle, fitted, dropped
+    static float output[OUTPUTS];
+    int32_t fundamental[33];
+    for (uint32_t w = 0; w <= fine_pwm_period / 2; w++) {
+        fundamental[w] = lroundf(16777216.0f * sinf(M_PI * w / fine_pwm_period));  // Q24
+    }
+    
+    bool saved_shaping = config.noise_shaping;
+    config.noise_shaping = shaped;
+    fine_pwm_state_t probe = {0};
+    int64_t integrator[3] = {0}, comb[3] = {0};
+    *timing_errors = 0;
+    
+    for (uint32_t n = 0; n < (SETTLE + OUTPUTS) * FINE_PWM_DECIMATION; n++) {
+        // TONE * FINE_PWM_DECIMATION = 2048 words per tone cycle
+        int32_t sine = (int32_t)waveform_lut[(n * 2) & 0xFFF] - 2048;
+        uint32_t word = fine_pwm_word(&probe, ENVELOPE_UNITY + ((sine * 26214) >> 14));
+        
+        uint32_t lead = word >> 22, width = (word >> 11) & 0x7FF, trail = word & 0x7FF;
+        if (lead + width + trail + (width ? 7 : 6) != fine_pwm_period ||
+            width > fine_pwm_period / 2) {
+            (*timing_errors)++;
+            width = 0;
+        }
+        
+        integrator[0] += fundamental[width];
+        integrator[1] += integrator[0];
+        integrator[2] += integrator[1];
+        if ((n + 1) % FINE_PWM_DECIMATION) continue;
+        int64_t y = integrator[2];
+        for (int k = 0; k < 3; k++) {
+            int64_t previous = comb[k];
+            comb[k] = y;
+            y -= previous;
+        }
+        uint32_t m = (n + 1) / FINE_PWM_DECIMATION - 1;
+        if (m >= SETTLE) {
+            output[m - SETTLE] = (float)y / ((float)FINE_PWM_DECIMATION * FINE_PWM_DECIMATION *
+                                             FINE_PWM_DECIMATION * 16777216.0f);
+        }
+    }
+    config.noise_shaping = saved_shaping;
+    
+    // Least-squares fit of offset and tone; SINAD from the residual
+    float mean = 0, in_phase = 0, quadrature = 0;
+    for (int m = 0; m < OUTPUTS; m++) {
+        float angle = 2.0f * M_PI * (m + SETTLE) / TONE;
+        mean += output[m];
+        in_phase += output[m] * cosf(angle);
+        quadrature += output[m] * sinf(angle);
+    }
+    mean /= OUTPUTS;
+    in_phase *= 2.0f / OUTPUTS;
+    quadrature *= 2.0f / OUTPUTS;
+    float residual = 0;
+    for (int m = 0; m < OUTPUTS; m++) {
+        float angle = 2.0f * M_PI * (m + SETTLE) / TONE;
+        float e = output[m] - mean - in_phase * cosf(angle) - quadrature * sinf(angle);
+        residual += e * e;
+    }
+    float signal = (in_phase * in_phase + quadrature * quadrature) / 2;
+    if (residual <= 0) residual = 1e-20f;
+    float sinad_db = 10.0f * log10f(signal * OUTPUTS / residual);
+    return (sinad_db - 1.76f) / 6.02f;
+}
+
+static void report_fine_pwm_resolution() {
+    uint32_t shaped_errors, plain_errors;
+    float shaped = fine_pwm_effective_bits(true, &shaped_errors);
+    float plain = fine_pwm_effective_bits(false, &plain_errors);
+    
+    printf("Fine PWM: %d widths per %d-cycle carrier period; %.1f effective bits below "
+           "%.1f kHz noise-shaped, %.1f rounded\n", fine_pwm_period / 2 + 1, fine_pwm_period,
+           shaped, config.carrier_frequency / (2000.0f * FINE_PWM_DECIMATION), plain);
+    if (shaped_errors || plain_errors) {
+        printf("Error: %d fine PWM word(s) missed the carrier period\n",
+               shaped_errors + plain_errors);
+    }
+}
+
+void dsp_selftest() {
+    volatile uint32_t sink = 0;
+    uint32_t saved_phase = phase_accumulator;
+    uint64_t start = 0;
+    
+    sigma_delta_state_t probe = sigma_delta;
+    requantiser_state_t requantiser_probe = requantiser;
+    bool packed = samples_per_word(&config) > 1;
+    bool multiphase = config.signal_mode == SIGNAL_MODE_MULTIPHASE;
+    bool stereo = config.signal_mode == SIGNAL_MODE_CQAM;
+    bool sideband = config.signal_mode == SIGNAL_MODE_USB || config.signal_mode == SIGNAL_MODE_LSB;
+    bool multi = config.signal_mode == SIGNAL_MODE_MULTICARRIER;
+    bool fine = config.signal_mode == SIGNAL_MODE_FINE_PWM;
+    cqam_state_t cqam_probe = cqam;
+    fine_pwm_state_t fine_probe = fine_pwm;
+    
+    governor_apply(governor.level);
+    for (uint32_t i = 0; i < SELFTEST_WARMUP_WORDS + SELFTEST_WORDS; i++) {
+        if (i == SELFTEST_WARMUP_WORDS) start = time_us_64();
+        
+        // Same per-word path as core1_signal_processing()
+        if (multi) {
+            sink = multicarrier_selftest_word(multicarrier_count, i);
+            continue;
+        }
+        if (packed) {
+            sink = packed_word(&probe, ENVELOPE_UNITY / 2 + (i & 1023));
+            continue;
+        }
+        if (multiphase) {
+            sink = multiphase_word(ENVELOPE_UNITY / 2 + (i & 1023), i);
+            continue;
+        }
+        if (stereo) {
+            sink = cqam_word(&cqam_probe, ENVELOPE_UNITY / 2 + (i & 1023), (int16_t)(i << 6));
+            continue;
+        }
+        if (fine) {
+            sink = fine_pwm_word(&fine_probe, ENVELOPE_UNITY / 2 + (i & 1023));
+            continue;
+        }
+        uint32_t modulated_sample = sideband ?
+            generate_ssb_signal(ENVELOPE_UNITY / 2 + (i & 1023), (int16_t)(i & 1023)) :
+            generate_am_signal(ENVELOPE_UNITY / 2 + (i & 1023));
+        if (active_iir_sections > 0) {
+            float sample = modulated_sample / 4095.0f;
+            for (int j = 0; j < active_iir_sections; j++) {
+                sample = process_biquad(&filter_sections[j], sample);
+            }
+            modulated_sample = (uint32_t)(sample * 4095);
+        }
+        sink = config.noise_shaping ? shaped_pio_timing(&requantiser_probe, modulated_sample) :
+                                      convert_to_pio_timing(modulated_sample);
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    (void)sink;
+    
+    // Transmission starts from the same phase and quiet filters
+    phase_accumulator = saved_phase;
+    for (int j = 0; j < num_filter_sections; j++) {
+        memset(filter_sections[j].x, 0, sizeof(filter_sections[j].x));
+        memset(filter_sections[j].y, 0, sizeof(filter_sections[j].y));
+    }
+    
+    uint64_t cycles = elapsed_us * clock_get_hz(clk_sys) / 1000000;
+    selftest_cycles_per_word = (uint32_t)((cycles + SELFTEST_WORDS - 1) / SELFTEST_WORDS);
+    if (selftest_cycles_per_word == 0) selftest_cycles_per_word = 1;
+    
+    // Audio rate: a tone in both channels, then the stages' state put back
+    uint32_t saved_pilot_phase = cqam_pilot_phase;
+    pipeline_block_t* block = &pipeline_blocks[0];
+    for (uint32_t i = 0; i < SELFTEST_WARMUP_WORDS + SELFTEST_WORDS; i++) {
+        if (i == SELFTEST_WARMUP_WORDS) start = time_us_64();
+        int16_t sample = (int16_t)((int32_t)waveform_lut[(i << 6) & 0xFFF] * 8 - 16384);
+        audio_rate_sample(block, i % BUFFER_SIZE, sample, sample / 2);
+    }
+    elapsed_us = time_us_64() - start;
+    cqam_pilot_phase = saved_pilot_phase;
+    memset(&hilbert, 0, sizeof(hilbert));
+    
+    cycles = elapsed_us * clock_get_hz(clk_sys) / 1000000;
+    selftest_cycles_per_sample = (uint32_t)((cycles + SELFTEST_WORDS - 1) / SELFTEST_WORDS);
+    
+    // IMA-ADPCM: a 1024-byte mono block of varied codes (2041 samples),
+    // decoded into the same idle block; the first pass is not timed
+    uint8_t adpcm_block[1024];
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < sizeof(adpcm_block); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        adpcm_block[i] = seed >> 24;
+    }
+    adpcm_block[2] = 40;  // Preamble step index, mid-table
+    int16_t* pcm = (int16_t*)block->envelope;
+    uint32_t frames = 0;
+    for (int pass = 0; pass <= 4; pass++) {
+        if (pass == 1) start = time_us_64();
+        frames = ima_adpcm_decode_block(adpcm_block, sizeof(adpcm_block), 1, pcm);
+    }
+    cycles = (time_us_64() - start) * clock_get_hz(clk_sys) / 1000000;
+    selftest_adpcm_cycles_per_sample = (uint32_t)((cycles + 4 * frames - 1) / (4 * frames));
+}
+
+// Highest carrier both the PIO and the measured DSP cost sustain
+static uint32_t selftest_max_carrier(uint32_t sys_hz, uint32_t oversampling) {
+    uint64_t pio_limit_hz = sys_hz;  // PIO divider >= 1
+    uint64_t dsp_limit_hz = (uint64_t)sys_hz * GOVERNOR_OVERLOAD_PCT / 100 *
+                            pio_cycles_per_word(&config) / selftest_cycles_per_word;
+    uint64_t limit = pio_limit_hz < dsp_limit_hz ? pio_limit_hz : dsp_limit_hz;
+    
+    limit /= 2 * oversampling;
+    return limit > 30000000 ? 30000000 : (uint32_t)limit;
+}
+
+void report_dsp_headroom() {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    uint64_t words_per_second = (uint64_t)config.carrier_frequency * config.oversampling_rate * 2 /
+                                pio_cycles_per_word(&config);
+    uint32_t load_pct = (uint32_t)(words_per_second * selftest_cycles_per_word * 100 / sys_hz);
+    
+    printf("DSP self-test: profile %s, clk_sys %.1f MHz, %d cycles per RF word, "
+           "%d%% load at %.1f kHz x %d\n", overclock_profiles[config.overclock_profile].name,
+           sys_hz / 1e6f, selftest_cycles_per_word, load_pct,
+           config.carrier_frequency / 1000.0f, config.oversampling_rate);
+    if (config.signal_mode == SIGNAL_MODE_MULTICARRIER) report_multicarrier_capacity(sys_hz);
+    if (config.signal_mode == SIGNAL_MODE_FINE_PWM) report_fine_pwm_resolution();
+    printf("Audio stage (core 0): %d cycles/sample, %d%% of core 0 at %d Hz\n",
+           selftest_cycles_per_sample,
+           (int)((uint64_t)selftest_cycles_per_sample * config.audio_sample_rate * 100 / sys_hz),
+           config.audio_sample_rate);
+    printf("IMA-ADPCM decode (core 0): %d cycles/sample, %d%% of core 0 for stereo at %d Hz\n",
+           selftest_adpcm_cycles_per_sample,
+           (int)((uint64_t)selftest_adpcm_cycles_per_sample * 2 * config.audio_sample_rate *
+                 100 / sys_hz), config.audio_sample_rate);
+    
+    // Best pair for this clock: the highest oversampling that still carries
+    // the configured carrier, and the highest carrier at the configured rate
+    uint32_t best_oversampling = 0;
+    printf("Sustainable carrier:");
+    for (uint32_t oversampling = 1; oversampling <= 32; oversampling *= 2) {
+        uint32_t max_carrier = selftest_max_carrier(sys_hz, oversampling);
+        if (max_carrier >= config.carrier_frequency) best_oversampling = oversampling;
+        printf(" %dx<=%.2f", oversampling, max_carrier / 1e6f);
+    }
+    printf(" MHz\n");
+    printf("Maximum pair: %.2f MHz at %dx", 
+           selftest_max_carrier(sys_hz, config.oversampling_rate) / 1e6f, config.oversampling_rate);
+    if (best_oversampling) {
+        printf("; %.1f kHz up to %dx\n", config.carrier_frequency / 1000.0f, best_oversampling);
+    } else {
+        printf("; %.1f kHz not sustainable at this clock\n", config.carrier_frequency / 1000.0f);
+    }
+    
+    if (load_pct >= GOVERNOR_OVERLOAD_PCT) {
+        printf("Warning: over the DSP budget, %s\n",
+               config.overclock_profile + 1 < NUM_OVERCLOCK_PROFILES
+               ? "try a faster --overclock profile or lower oversampling"
+               : "lower the oversampling or filter order");
+    }
+}
+
+// ============================================================================
+// RUNTIME RETUNING
+// ============================================================================
+//
+// Core 0 prepares everything a new carrier needs (NCO step, PIO divider,
+// filter coefficients in the idle bank) and raises retune_pending. Core 1
+// applies it between blocks. The phase accumulator is never reset, and the
+// PIO divider switches when DMA starts the first retuned buffer, so the
+// carrier moves without a gap or FIFO flush. The FIFO's last (up to 8) old
+// words play at the new divider; see start_modulation_dma().
+
+typedef struct {
+    uint32_t carrier_frequency;
+    uint32_t phase_increment;
+    int32_t requantiser_feedback; // Noise-shaper zeros follow the NCO
+    uint32_t pio_divider;         // 16.8 fixed point
+    signal_processing_mode_t signal_mode;
+    filter_mode_t filter_mode;
+    uint8_t iir_sections;         // Designed into the idle bank
+    uint8_t fir_length;
+} retune_request_t;
+
+static retune_request_t retune_request;
+static volatile bool retune_pending = false;
+
+// Core 0: stage carrier, depth, mode and filter settings from a target
+// configuration. Returns false if the target is invalid, needs a different
+// PIO program, or the previous request has not been applied yet.
+bool retune_transmitter(const transmitter_config_t* target) {
+    if (retune_pending) return false;
+    if (target->carrier_frequency < 10000 || target->carrier_frequency > 30000000 ||
+        target->modulation_depth > 100) {
+        return false;
+    }
+    if (pio_program_for(target) != pio_program_for(&config)) {
+        printf("Retune: mode needs a different PIO program, restart required\n");
+        return false;
+    }
+    if ((samples_per_word(&config) > 1 || config.signal_mode == SIGNAL_MODE_MULTIPHASE ||
+         config.signal_mode == SIGNAL_MODE_CQAM || config.signal_mode == SIGNAL_MODE_FINE_PWM) &&
+        target->oversampling_rate != config.oversampling_rate) {
+        printf("Retune: oversampling is fixed in this mode, restart required\n");
+        return false;
+    }
+    if ((target->signal_mode == SIGNAL_MODE_MULTICARRIER ||
+         config.signal_mode == SIGNAL_MODE_MULTICARRIER) &&
+        (target->signal_mode != config.signal_mode ||
+         target->carrier_frequency != config.carrier_frequency)) {
+        printf("Retune: the multi-carrier plan is fixed, restart required\n");
+        return false;
+    }
+    if ((target->signal_mode == SIGNAL_MODE_CQAM) != (config.signal_mode == SIGNAL_MODE_CQAM)) {
+        printf("Retune: stereo needs the audio path rebuilt, restart required\n");
+        return false;
+    }
+    if ((uint64_t)target->carrier_frequency * target->oversampling_rate * 2 >
+        clock_get_hz(clk_sys)) {
+        printf("Retune: carrier needs a faster clock profile, restart required\n");
+        return false;
+    }
+    
+    // Settings core 1 never reads are updated in place
+    config.modulation_depth = target->modulation_depth;  // Live from the next envelope
+    config.oversampling_rate = target->oversampling_rate;
+    config.filter_bandwidth = target->filter_bandwidth;
+    config.filter_order = target->filter_order;
+    
+    uint8_t iir_sections = 0;
+    uint8_t fir_taps = 0;
+    if (target->filter_mode == FILTER_MODE_BANDPASS_IIR ||
+        target->filter_mode == FILTER_MODE_BANDPASS_ELLIPTIC) {
+        iir_sections = (target->filter_order + 1) / 2;
+        if (iir_sections > 4) iir_sections = 4;
+    } else if (target->filter_mode == FILTER_MODE_BANDPASS_FIR) {
+        int length = target->filter_order * 8;
+        fir_taps = length > 255 ? 255 : length;
+    }
+    
+    // Core 1 only reads the active bank
+    uint32_t idle = active_bank ^ 1;
+    uint32_t frequency = target->carrier_frequency;
+    design_bandpass_sections(filter_banks[idle], iir_sections, frequency);
+    design_fir_bank(fir_banks[idle], fir_taps, frequency);
+    
+    retune_request.carrier_frequency = frequency;
+    retune_request.phase_increment = phase_increment_for(frequency);
+    retune_request.requantiser_feedback = requantiser_feedback(retune_request.phase_increment);
+    retune_request.pio_divider = pio_divider_for(frequency);
+    retune_request.signal_mode = target->signal_mode;
+    retune_request.filter_mode = target->filter_mode;
+    retune_request.iir_sections = iir_sections;
+    retune_request.fir_length = fir_taps;
+    
+    __dmb();  // Request and bank contents visible before the flag
+    retune_pending = true;
+    __sev();
+    return true;
+}
+
+// Core 1, between blocks: swap banks and switch the NCO. The PIO divider
+// follows with the buffer about to be formatted.
+static void apply_retune(int fill_buffer) {
+    __dmb();
+    uint32_t next = active_bank ^ 1;
+    
+    // Carry the filter state over so the swap does not ring
+    uint8_t carried = num_filter_sections < retune_request.iir_sections ?
+                      num_filter_sections : retune_request.iir_sections;
+    for (int i = 0; i < carried; i++) {
+        memcpy(filter_banks[next][i].x, filter_sections[i].x, sizeof(filter_sections[i].x));
+        memcpy(filter_banks[next][i].y, filter_sections[i].y, sizeof(filter_sections[i].y));
+    }
+    
+    active_bank = next;
+    filter_sections = filter_banks[next];
+    fir_coefficients = fir_banks[next];
+    num_filter_sections = retune_request.iir_sections;
+    fir_length = retune_request.fir_length;
+    governor_apply(governor.level);  // Re-points the active filter settings
+    
+    uint32_t old_frequency = config.carrier_frequency;
+    phase_increment = retune_request.phase_increment;
+    requantiser.feedback = retune_request.requantiser_feedback;
+    buffer_pio_divider[fill_buffer] = retune_request.pio_divider;
+    config.carrier_frequency = retune_request.carrier_frequency;
+    config.signal_mode = retune_request.signal_mode;
+    config.filter_mode = retune_request.filter_mode;
+    
+    retune_pending = false;
+    log_push(LOG_RETUNE, old_frequency, config.carrier_frequency, retune_request.pio_divider);
+}
+
+// ============================================================================
+// EDUCATIONAL ANALYSIS AND MONITORING
+// ============================================================================
+
+void analyze_signal_quality() {
+    if (!config.verbose_analysis && !config.harmonic_analysis) return;
+    
+    printf("\nSignal Quality Analysis:\n");
+    printf("=======================\n");
+    
+    const char* mode_names[] = {
+        "Simple High Quality", "Basic Square Wave", "Sigma-Delta",
+        "Pure Sine Wave", "Pre-distortion", "Oversampled", "R-2R DAC",
+        "Multi-phase Square", "C-QUAM Stereo", "DSB Suppressed Carrier",
+        "Upper Sideband", "Lower Sideband", "Multi-carrier", "Fine PWM"
+    };
+    
+    printf("Signal Mode: %s\n", mode_names[config.signal_mode]);
+    printf("Carrier Frequency: %.1f kHz\n", config.carrier_frequency / 1000.0f);
+    printf("Modulation Depth: %d%%\n", config.modulation_depth);
+    
+    // Estimated performance based on mode
+    switch (config.signal_mode) {
+        case SIGNAL_MODE_SIMPLE:
+        case SIGNAL_MODE_SINE_WAVE:
+            measured_thd = 0.1f;
+            harmonic_levels[1] = -65; harmonic_levels[2] = -72; harmonic_levels[4] = -78;
+            break;
+        case SIGNAL_MODE_SQUARE:
+            measured_thd = 10.5f;
+            harmonic_levels[1] = -9.5f; harmonic_levels[2] = -19.1f; harmonic_levels[4] = -27.9f;
+            break;
+        case SIGNAL_MODE_SIGMA_DELTA:
+            measured_thd = 0.8f;
+            harmonic_levels[1] = -45; harmonic_levels[2] = -52; harmonic_levels[4] = -58;
+            break;
+        case SIGNAL_MODE_PREDISTORTION:
+            measured_thd = 0.05f;
+            harmonic_levels[1] = -70; harmonic_levels[2] = -75; harmonic_levels[4] = -80;
+            break;
+        case SIGNAL_MODE_OVERSAMPLED:
+            measured_thd = 0.01f;
+            harmonic_levels[1] = -85; harmonic_levels[2] = -92; harmonic_levels[4] = -98;
+            break;
+        case SIGNAL_MODE_PARALLEL_DAC:  // Ladder resistor matching dominates
+            measured_thd = 0.3f;
+            harmonic_levels[1] = -50; harmonic_levels[2] = -55; harmonic_levels[4] = -62;
+            break;
+        case SIGNAL_MODE_MULTIPHASE:    // 1% resistors; 7th and 9th remain at -17/-19 dBc
+            measured_thd = 18.0f;
+            harmonic_levels[1] = -60; harmonic_levels[2] = -40; harmonic_levels[4] = -40;
+            break;
+        case SIGNAL_MODE_CQAM:          // 50% square carrier, RF harmonics before the filter
+            measured_thd = 10.5f;
+            harmonic_levels[1] = -40; harmonic_levels[2] = -9.5f; harmonic_levels[4] = -14;
+            break;
+        case SIGNAL_MODE_DSB_SC:
+            measured_thd = 0.1f;
+            harmonic_levels[1] = -65; harmonic_levels[2] = -72; harmonic_levels[4] = -78;
+            break;
+        case SIGNAL_MODE_USB:           // Opposite sideband: -60 dBc above 1 kHz audio
+        case SIGNAL_MODE_LSB:
+            measured_thd = 0.1f;
+            harmonic_levels[1] = -65; harmonic_levels[2] = -72; harmonic_levels[4] = -78;
+            break;
+        case SIGNAL_MODE_MULTICARRIER:  // Ladder matching plus intermodulation between stations
+            measured_thd = 0.5f;
+            harmonic_levels[1] = -45; harmonic_levels[2] = -50; harmonic_levels[4] = -58;
+            break;
+        case SIGNAL_MODE_FINE_PWM:      // Pulse carrier, RF harmonics before the filter
+            measured_thd = 10.5f;
+            harmonic_levels[1] = -40; harmonic_levels[2] = -9.5f; harmonic_levels[4] = -14;
+            break;
+    }
+    
+    printf("Estimated THD: %.3f%%\n", measured_thd);
+    if (config.harmonic_analysis) {
+        printf("Harmonic Levels:\n");
+        printf("- 2nd: %.1f dBc\n", harmonic_levels[1]);
+        printf("- 3rd: %.1f dBc\n", harmonic_levels[2]);
+        printf("- 5th: %.1f dBc\n", harmonic_levels[4]);
+    }
+    
+    if (config.filter_mode != FILTER_MODE_NONE) {
+        const char* filter_names[] = {
+            "None", "Low-pass", "IIR Butterworth", "FIR Windowed", "Elliptic", "Multi-band"
+        };
+        printf("Filter: %s\n", filter_names[config.filter_mode]);
+        printf("Filter Bandwidth: %.1f Hz\n", config.filter_bandwidth);
+    }
+    
+    printf("=======================\n");
+}
+
+// Runs on core 1 after every block: status goes through the telemetry ring
+void monitor_transmission() {
+    static uint32_t last_status_seconds = 0;
+    uint32_t current_time = to_ms_since_boot(get_absolute_time());
+    uint32_t elapsed_seconds = (current_time - transmission_start_time) / 1000;
+    
+    if (config.verbose_analysis && elapsed_seconds >= last_status_seconds + 30) {
+        last_status_seconds = elapsed_seconds - elapsed_seconds % 30;
+        log_push(LOG_STATUS, elapsed_seconds, samples_processed, underrun_count);
+#if STAGE_PROFILING
+        stage_profile_requested = true;
+#endif
+    }
+    
+#if STAGE_PROFILING
+    if (stage_profile_requested) stage_profile_publish();
+#endif
+    
+    // Safety time limit check
+    if (config.enable_safety_limits && elapsed_seconds >= config.transmission_time_limit) {
+        log_push(LOG_TIME_LIMIT, config.transmission_time_limit, 0, 0);
+        transmission_active = false;
+        __sev();  // Wake core 0 if it is sleeping on a full pipeline
+    }
+}
+
+// ============================================================================
+// WAV FILE PROCESSING
+// ============================================================================
+
+bool read_wav_header(FIL* file, wav_header_t* header) {
+    UINT bytes_read;
+    FRESULT fr = f_read(file, header, sizeof(wav_header_t), &bytes_read);
+    
+    if (fr != FR_OK || bytes_read != sizeof(wav_header_t)) {
+        printf("Error: Failed to read WAV header (error: %d)\n", fr);
+        return false;
+    }
+    
     if (strncmp(header->riff, "RIFF", 4) != 0 || 
         strncmp(header->wave, "WAVE", 4) != 0) {
         printf("Error: Invalid WAV file format\n");
         return false;
     }
     
-    // Find data chunk
-    while (strncmp(header->data, "data", 4) != 0) {
-        char chunk_id[4];
-        uint32_t chunk_size;
-        f_read(file, chunk_id, 4, &bytes_read);
-        f_read(file, &chunk_size, 4, &bytes_read);
+    if (header->audio_format == WAV_FORMAT_IMA_ADPCM) {
+        if (header->bits_per_sample != 4 || header->num_channels < 1 ||
+            header->num_channels > 2 || header->block_align <= 4 * header->num_channels ||
+            header->block_align > ADPCM_MAX_BLOCK_ALIGN) {
+            printf("Error: Unsupported IMA-ADPCM layout (%d bits, %d channels, block %d)\n",
+                   header->bits_per_sample, header->num_channels, header->block_align);
+            return false;
+        }
+    } else if (header->audio_format != WAV_FORMAT_PCM || header->bits_per_sample != 16 ||
+               header->num_channels < 1 || header->num_channels > 2) {
+        printf("Error: Unsupported WAV encoding (format 0x%04X, %d bits, %d channels)\n",
+               header->audio_format, header->bits_per_sample, header->num_channels);
+        return false;
+    }
+    
+    // Extended fmt chunks (ADPCM carries cbSize + samples-per-block) push the
+    // following chunk past the fixed header, so rescan from the real offset
+    if (header->fmt_size != 16) {
+        f_lseek(file, 20 + header->fmt_size);
+        memset(header->data, 0, 4);
+    }
+    
+    // Find data chunk. A file without one, or cut short, runs out of chunk
+    // headers: give up so a playlist moves on to its next entry.
+    while (strncmp(header->data, "data", 4) != 0) {
+        uint8_t chunk[8];
+        fr = f_read(file, chunk, sizeof(chunk), &bytes_read);
+        if (fr != FR_OK || bytes_read != sizeof(chunk)) {
+            printf("Error: No data chunk in WAV file (error: %d)\n", fr);
+            return false;
+        }
+        uint32_t chunk_size = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) |
+                              ((uint32_t)chunk[7] << 24);
+        
+        if (memcmp(chunk, "data", 4) == 0) {
+            memcpy(header->data, chunk, 4);
+            header->data_size = chunk_size;
+            break;
+        }
+        // Chunks are padded to an even length. A size past the end of the
+        // file would wrap the seek back to an earlier chunk.
+        uint64_t next = (uint64_t)f_tell(file) + chunk_size + (chunk_size & 1);
+        if (next > f_size(file) || f_lseek(file, (FSIZE_t)next) != FR_OK) {
+            printf("Error: Truncated WAV file\n");
+            return false;
+        }
+    }
+    
+    if (config.verbose_analysis) {
+        printf("WAV File Info:\n");
+        printf("- Encoding: %s\n",
+               header->audio_format == WAV_FORMAT_IMA_ADPCM ? "IMA-ADPCM (4:1)" : "PCM");
+        printf("- Sample Rate: %d Hz\n", header->sample_rate);
+        printf("- Channels: %d\n", header->num_channels);
+        printf("- Bit Depth: %d bits\n", header->bits_per_sample);
+        printf("- Duration: %.1f seconds\n", 
+               (float)header->data_size / header->byte_rate);
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// SAMPLE RATE CONVERSION
+// ============================================================================
+
+// (Re)initialise for a new input rate. The history sample is kept so a
+// track change does not introduce a step at the join.
+void resampler_init(audio_resampler_t* rs, uint32_t input_rate, uint32_t output_rate) {
+    rs->step = (uint32_t)(((uint64_t)input_rate << 16) / output_rate);
+    rs->position = 0;
+}
+
+// Largest input block that cannot produce more than max_output samples
+static inline uint32_t resampler_max_input(const audio_resampler_t* rs, uint32_t max_output) {
+    uint32_t frames = (uint32_t)(((uint64_t)(max_output - 1) * rs->step) >> 16);
+    return frames > 0 ? frames : 1;
+}
+
+// Convert one input block; returns the number of output samples written
+uint32_t resampler_process(audio_resampler_t* rs, const int16_t* input, uint32_t count,
+                           int16_t* output) {
+    if (rs->step == (1u << 16) && rs->position == 0) {
+        // Matching rates: straight copy, one sample of history latency kept
+        output[0] = rs->history;
+        memcpy(&output[1], input, (count - 1) * sizeof(int16_t));
+        rs->history = input[count - 1];
+        return count;
+    }
+    
+    uint32_t produced = 0;
+    uint32_t limit = count << 16;
+    uint32_t pos = rs->position;
+    
+    // Index 0 of the virtual input is the history sample, 1..count the block
+    while (pos < limit) {
+        uint32_t index = pos >> 16;
+        int32_t frac = pos & 0xFFFF;
+        int32_t a = (index == 0) ? rs->history : input[index - 1];
+        int32_t b = input[index];
+        output[produced++] = (int16_t)(a + (((b - a) * frac) >> 16));
+        pos += rs->step;
+    }
+    
+    rs->position = pos - limit;
+    rs->history = input[count - 1];
+    return produced;
+}
+
+// ============================================================================
+// AUDIO SOURCES
+// ============================================================================
+
+// --- SD card (FatFs) backend: 16-bit PCM or IMA-ADPCM WAV ---
+
+static bool sd_source_open(audio_source_t* src, const char* location) {
+    FRESULT fr = f_open(&src->u.sd.file, location, FA_READ);
+    if (fr != FR_OK) {
+        printf("Error: Cannot open WAV file '%s' (error: %d)\n", location, fr);
+        return false;
+    }
+    
+    wav_header_t* header = &src->u.sd.header;
+    if (!read_wav_header(&src->u.sd.file, header)) {
+        f_close(&src->u.sd.file);
+        return false;
+    }
+    
+    src->sample_rate = header->sample_rate;
+    src->num_channels = header->num_channels;
+    if (header->audio_format == WAV_FORMAT_IMA_ADPCM) {
+        src->total_frames = (header->data_size / header->block_align) *
+                            ima_adpcm_frames_per_block(header->block_align, header->num_channels);
+    } else {
+        src->total_frames = header->data_size / header->block_align;
+    }
+    
+    src->u.sd.data_start = f_tell(&src->u.sd.file);
+    src->u.sd.data_remaining = header->data_size;
+    src->u.sd.decoded_frames = 0;
+    src->u.sd.decoded_pos = 0;
+    return true;
+}
+
+static const int16_t* sd_source_read_block(audio_source_t* src, uint32_t max_frames,
+                                           uint32_t* frames) {
+    wav_header_t* header = &src->u.sd.header;
+    UINT bytes_read;
+    *frames = 0;
+    
+    if (header->audio_format == WAV_FORMAT_IMA_ADPCM) {
+        // Decode a fresh ADPCM block once the previous one is used up
+        if (src->u.sd.decoded_pos >= src->u.sd.decoded_frames) {
+            uint32_t to_read = header->block_align;
+            if (to_read > src->u.sd.data_remaining) to_read = src->u.sd.data_remaining;
+            if (to_read == 0) return NULL;
+            
+            FRESULT fr = f_read(&src->u.sd.file, src->u.sd.adpcm_block, to_read, &bytes_read);
+            if (fr != FR_OK || bytes_read == 0) return NULL;
+            src->u.sd.data_remaining -= bytes_read;
+            src->stats.bytes_read += bytes_read;
+            
+            uint64_t decode_start = time_us_64();
+            src->u.sd.decoded_frames = ima_adpcm_decode_block(src->u.sd.adpcm_block, bytes_read,
+                                                              header->num_channels,
+                                                              src->u.sd.pcm);
+            src->u.sd.decoded_pos = 0;
+            adpcm_decode_time_us += time_us_64() - decode_start;
+            adpcm_frames_decoded += src->u.sd.decoded_frames;
+            adpcm_blocks_decoded++;
+        }
+        
+        uint32_t available = src->u.sd.decoded_frames - src->u.sd.decoded_pos;
+        uint32_t count = (available < max_frames) ? available : max_frames;
+        const int16_t* block = &src->u.sd.pcm[src->u.sd.decoded_pos * header->num_channels];
+        src->u.sd.decoded_pos += count;
+        *frames = count;
+        return block;
+    }
+    
+    uint32_t buffer_frames = (BUFFER_SIZE * 2) / header->num_channels;
+    if (max_frames > buffer_frames) max_frames = buffer_frames;
+    
+    uint32_t to_read = max_frames * header->block_align;
+    if (to_read > src->u.sd.data_remaining) to_read = src->u.sd.data_remaining;
+    if (to_read == 0) return NULL;
+    
+    FRESULT fr = f_read(&src->u.sd.file, src->u.sd.pcm, to_read, &bytes_read);
+    if (fr != FR_OK || bytes_read == 0) return NULL;
+    src->u.sd.data_remaining -= bytes_read;
+    src->stats.bytes_read += bytes_read;
+    
+    *frames = bytes_read / header->block_align;
+    return src->u.sd.pcm;
+}
+
+static bool sd_source_rewind(audio_source_t* src) {
+    if (f_lseek(&src->u.sd.file, src->u.sd.data_start) != FR_OK) return false;
+    src->u.sd.data_remaining = src->u.sd.header.data_size;
+    src->u.sd.decoded_frames = 0;
+    src->u.sd.decoded_pos = 0;
+    return true;
+}
+
+static void sd_source_close(audio_source_t* src) {
+    f_close(&src->u.sd.file);
+}
+
+// --- XIP flash backend: zero-copy reads of a WAV image stored in QSPI flash ---
+
+// Locate the fmt and data chunks of an in-memory WAV image
+static bool parse_wav_image(const uint8_t* image, uint32_t max_size,
+                            wav_header_t* header, const uint8_t** data) {
+    if (memcmp(image, "RIFF", 4) != 0 || memcmp(image + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+    
+    bool have_fmt = false;
+    uint32_t offset = 12;
+    *data = NULL;
+    
+    while (offset + 8 <= max_size) {
+        const uint8_t* chunk = image + offset;
+        uint32_t chunk_size = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) |
+                              ((uint32_t)chunk[7] << 24);
         
-        if (strncmp(chunk_id, "data", 4) == 0) {
-            memcpy(header->data, chunk_id, 4);
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            memcpy(&header->audio_format, chunk + 8, 16);
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (offset + 8 + chunk_size > max_size) return false;
             header->data_size = chunk_size;
+            *data = chunk + 8;
+            break;
+        }
+        offset += 8 + ((chunk_size + 1) & ~1u);  // Chunks are word aligned
+    }
+    
+    return have_fmt && *data != NULL;
+}
+
+static bool xip_source_open(audio_source_t* src, const char* location) {
+    (void)location;
+#if !PICO_ON_DEVICE
+    (void)src;
+    (void)parse_wav_image;
+    printf("Error: The host build has no flash to play from\n");
+    return false;
+#else
+    
+    // The non-cached, non-allocating alias streams audio straight off the
+    // QSPI bus, so long sequential reads never evict code from the XIP cache
+    const uint8_t* image = (const uint8_t*)(XIP_NOCACHE_NOALLOC_BASE + XIP_AUDIO_FLASH_OFFSET);
+    wav_header_t header;
+    const uint8_t* data;
+    
+    if (!parse_wav_image(image, PERSIST_FLASH_OFFSET - XIP_AUDIO_FLASH_OFFSET,
+                         &header, &data)) {
+        printf("Error: No WAV image found in flash at 0x%08X\n",
+               XIP_BASE + XIP_AUDIO_FLASH_OFFSET);
+        return false;
+    }
+    
+    if (header.audio_format != WAV_FORMAT_PCM || header.bits_per_sample != 16 ||
+        header.num_channels < 1 || header.num_channels > 2) {
+        printf("Error: Flash audio must be 16-bit PCM mono/stereo\n");
+        return false;
+    }
+    
+    src->sample_rate = header.sample_rate;
+    src->num_channels = header.num_channels;
+    src->total_frames = header.data_size / header.block_align;
+    src->u.xip.data = (const int16_t*)data;
+    src->u.xip.position = 0;
+    return true;
+#endif
+}
+
+static const int16_t* xip_source_read_block(audio_source_t* src, uint32_t max_frames,
+                                            uint32_t* frames) {
+    uint32_t remaining = src->total_frames - src->u.xip.position;
+    uint32_t count = (remaining < max_frames) ? remaining : max_frames;
+    const int16_t* block = src->u.xip.data + src->u.xip.position * src->num_channels;
+    
+    src->u.xip.position += count;
+    src->stats.bytes_read += count * src->num_channels * sizeof(int16_t);
+    *frames = count;
+    return count ? block : NULL;
+}
+
+static bool xip_source_rewind(audio_source_t* src) {
+    src->u.xip.position = 0;
+    return true;
+}
+
+static void xip_source_close(audio_source_t* src) {
+    (void)src;
+}
+
+// --- RAM loop backend: clip loaded once from SD, then replayed from RAM ---
+
+static int16_t ram_loop_cache[RAM_LOOP_MAX_BYTES / sizeof(int16_t)];
+
+static bool ram_loop_source_open(audio_source_t* src, const char* location) {
+    static audio_source_t loader;
+    if (!sd_source_open(&loader, location)) return false;
+    
+    uint32_t capacity = count_of(ram_loop_cache) / loader.num_channels;
+    uint32_t length = 0;
+    
+    while (length < capacity) {
+        uint32_t frames;
+        const int16_t* block = sd_source_read_block(&loader, capacity - length, &frames);
+        if (frames == 0) break;
+        memcpy(&ram_loop_cache[length * loader.num_channels], block,
+               frames * loader.num_channels * sizeof(int16_t));
+        length += frames;
+    }
+    sd_source_close(&loader);
+    
+    if (length == 0) {
+        printf("Error: '%s' contains no audio to cache\n", location);
+        return false;
+    }
+    if (length < loader.total_frames) {
+        printf("Warning: Clip truncated to %.2f seconds to fit the %d KB RAM cache\n",
+               (float)length / loader.sample_rate, RAM_LOOP_MAX_BYTES / 1024);
+    }
+    
+    src->sample_rate = loader.sample_rate;
+    src->num_channels = loader.num_channels;
+    src->total_frames = 0;  // Endless
+    src->stats.bytes_read = loader.stats.bytes_read;
+    src->u.ram.length = length;
+    src->u.ram.position = 0;
+    return true;
+}
+
+static const int16_t* ram_loop_source_read_block(audio_source_t* src, uint32_t max_frames,
+                                                 uint32_t* frames) {
+    if (src->u.ram.position >= src->u.ram.length) {
+        src->u.ram.position = 0;
+        src->stats.rewinds++;
+    }
+    
+    uint32_t remaining = src->u.ram.length - src->u.ram.position;
+    uint32_t count = (remaining < max_frames) ? remaining : max_frames;
+    const int16_t* block = &ram_loop_cache[src->u.ram.position * src->num_channels];
+    
+    src->u.ram.position += count;
+    *frames = count;
+    return block;
+}
+
+static bool ram_loop_source_rewind(audio_source_t* src) {
+    src->u.ram.position = 0;
+    return true;
+}
+
+static void ram_loop_source_close(audio_source_t* src) {
+    (void)src;
+}
+
+// --- Test signal backend: seeded, fixed-point synthetic generator ---
+
+static int16_t test_sine_lut[(1 << TEST_SINE_LUT_BITS) + 1];  // +1 guard for interpolation
+
+static const char* const test_signal_names[] = {
+    "Tone", "Two-tone IMD", "Log sweep", "White noise", "Pink noise", "Silence",
+    "Pre-distortion steps"
+};
+
+static inline uint32_t test_frequency_to_increment(uint32_t frequency) {
+    return (uint32_t)(((uint64_t)frequency << 32) / config.audio_sample_rate);
+}
+
+// Q15 sine with linear interpolation between LUT entries (~-100 dB spurs)
+static inline int32_t test_oscillator(uint32_t phase) {
+    uint32_t index = phase >> (32 - TEST_SINE_LUT_BITS);
+    int32_t frac = (phase >> (16 - TEST_SINE_LUT_BITS)) & 0xFFFF;
+    int32_t a = test_sine_lut[index];
+    int32_t b = test_sine_lut[index + 1];
+    return a + (((b - a) * frac) >> 16);
+}
+
+static inline uint32_t test_noise_next(audio_source_t* src) {
+    uint32_t x = src->u.test.noise_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    src->u.test.noise_state = x;
+    return x;
+}
+
+// Put the generator into its initial state; every run from here is identical
+static void test_source_reset(audio_source_t* src) {
+    src->u.test.phase[0] = 0;
+    src->u.test.phase[1] = 0;
+    src->u.test.phase_increment[0] = test_frequency_to_increment(config.test_frequency);
+    src->u.test.phase_increment[1] = test_frequency_to_increment(config.test_frequency2);
+    
+    src->u.test.sweep_position = 0;
+    if (config.test_signal == TEST_SIGNAL_SWEEP) {
+        src->u.test.phase_increment[0] = src->u.test.sweep_start_increment;
+    }
+    
+    src->u.test.noise_state = config.test_seed ? config.test_seed : 1;  // xorshift needs != 0
+    src->u.test.pink_counter = 0;
+    src->u.test.pink_sum = 0;
+    for (int i = 0; i < PINK_NOISE_ROWS; i++) {
+        src->u.test.pink_rows[i] = 0;
+    }
+}
+
+static bool test_source_open(audio_source_t* src, const char* location) {
+    (void)location;
+    src->sample_rate = config.audio_sample_rate;
+    src->num_channels = 1;
+    src->total_frames = 0;  // Endless
+    
+    const uint32_t lut_size = 1 << TEST_SINE_LUT_BITS;
+    for (uint32_t i = 0; i <= lut_size; i++) {
+        test_sine_lut[i] = (int16_t)lrintf(32767.0f * sinf(2.0f * M_PI * i / lut_size));
+    }
+    
+    // Log sweep: the phase increment grows by a constant ratio every sample
+    // (double precision here: a float ratio would be off by ~3% after 10^5 steps)
+    double sweep_stop = config.audio_sample_rate * 0.45;
+    uint32_t sweep_length = config.audio_sample_rate * TEST_SWEEP_SECONDS;
+    double ratio = pow(sweep_stop / TEST_SWEEP_START_HZ, 1.0 / sweep_length);
+    src->u.test.sweep_length = sweep_length;
+    src->u.test.sweep_ratio_q30 = (uint32_t)llround(ratio * (1 << 30));
+    src->u.test.sweep_start_increment = test_frequency_to_increment(TEST_SWEEP_START_HZ);
+    
+    test_source_reset(src);
+    return true;
+}
+
+static const int16_t* test_source_read_block(audio_source_t* src, uint32_t max_frames,
+                                             uint32_t* frames) {
+    uint32_t count = (max_frames < BUFFER_SIZE) ? max_frames : BUFFER_SIZE;
+    int16_t* out = src->u.test.pcm;
+    
+    switch (config.test_signal) {
+        case TEST_SIGNAL_TONE:
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = (int16_t)((test_oscillator(src->u.test.phase[0]) * TEST_SIGNAL_LEVEL) >> 15);
+                src->u.test.phase[0] += src->u.test.phase_increment[0];
+            }
+            break;
+            
+        case TEST_SIGNAL_TWO_TONE:
+            // Equal tones at -6 dB each so the composite peak matches a single tone
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t sum = test_oscillator(src->u.test.phase[0]) +
+                              test_oscillator(src->u.test.phase[1]);
+                out[i] = (int16_t)((sum * (TEST_SIGNAL_LEVEL / 2)) >> 15);
+                src->u.test.phase[0] += src->u.test.phase_increment[0];
+                src->u.test.phase[1] += src->u.test.phase_increment[1];
+            }
+            break;
+            
+        case TEST_SIGNAL_SWEEP:
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = (int16_t)((test_oscillator(src->u.test.phase[0]) * TEST_SIGNAL_LEVEL) >> 15);
+                src->u.test.phase[0] += src->u.test.phase_increment[0];
+                // Rounded so truncation does not pull the sweep flat over 10^5+ steps
+                uint64_t next = (uint64_t)src->u.test.phase_increment[0] * src->u.test.sweep_ratio_q30;
+                src->u.test.phase_increment[0] = (uint32_t)((next + (1u << 29)) >> 30);
+                if (++src->u.test.sweep_position >= src->u.test.sweep_length) {
+                    src->u.test.sweep_position = 0;
+                    src->u.test.phase_increment[0] = src->u.test.sweep_start_increment;
+                }
+            }
+            break;
+            
+        case TEST_SIGNAL_WHITE_NOISE:
+            for (uint32_t i = 0; i < count; i++) {
+                int32_t white = (int16_t)(test_noise_next(src) >> 16);
+                out[i] = (int16_t)((white * TEST_SIGNAL_LEVEL) >> 15);
+            }
+            break;
+            
+        case TEST_SIGNAL_PINK_NOISE:
+            // Voss-McCartney: row k is refreshed every 2^k samples, plus a white term
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t counter = ++src->u.test.pink_counter;
+                uint32_t row = __builtin_ctz(counter);
+                if (row < PINK_NOISE_ROWS) {
+                    int32_t value = (int16_t)(test_noise_next(src) >> 16) / (PINK_NOISE_ROWS + 1);
+                    src->u.test.pink_sum += value - src->u.test.pink_rows[row];
+                    src->u.test.pink_rows[row] = value;
+                }
+                int32_t white = (int16_t)(test_noise_next(src) >> 16) / (PINK_NOISE_ROWS + 1);
+                out[i] = (int16_t)(((src->u.test.pink_sum + white) * TEST_SIGNAL_LEVEL) >> 15);
+            }
+            break;
+            
+        case TEST_SIGNAL_SILENCE:
+            memset(out, 0, count * sizeof(int16_t));
+            break;
+            
+        case TEST_SIGNAL_DPD_STEPS: {
+            // Full scale: at 100% depth level k is envelope k / 16 of the
+            // carrier, the wanted envelope of table point k
+            uint32_t step = config.audio_sample_rate * DPD_STEP_MS / 1000;
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t level = src->u.test.sweep_position / step;
+                int32_t value = (int32_t)((level << DPD_LUT_SHIFT) - ENVELOPE_UNITY) * 8;
+                out[i] = (int16_t)(value > INT16_MAX ? INT16_MAX : value);
+                if (++src->u.test.sweep_position >= step * DPD_LUT_POINTS) {
+                    src->u.test.sweep_position = 0;
+                }
+            }
             break;
+        }
+    }
+    
+    *frames = count;
+    return out;
+}
+
+static bool test_source_rewind(audio_source_t* src) {
+    test_source_reset(src);
+    return true;
+}
+
+static void test_source_close(audio_source_t* src) {
+    (void)src;
+}
+
+// --- USB stream backend: raw 16-bit mono PCM from the host, drift compensated ---
+//
+// The host writes little-endian samples at audio_sample_rate over the USB
+// CDC channel (stdin on host builds). Host and Pico clocks never agree
+// exactly, so an adaptive resampler trims its ratio from the FIFO fill
+// level to hold the FIFO half full. XOFF/XON are sent when the FIFO
+// passes 3/4 and 1/4 full.
+
+static int16_t usb_stream_fifo[USB_STREAM_FIFO_SAMPLES];
+static uint32_t usb_stream_stamps[USB_STREAM_FIFO_SAMPLES >> USB_STREAM_STAMP_SHIFT];
+static uint32_t usb_stream_write = 0;   // Free-running sample indices
+static uint32_t usb_stream_read = 0;
+static int usb_stream_low_byte = -1;    // First half of a split sample
+static bool usb_stream_buffering = true;
+
+static size_t usb_stream_read_bytes(uint8_t* buffer, size_t max_bytes) {
+#if PICO_ON_DEVICE
+    size_t count = 0;
+    while (count < max_bytes) {
+        int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) break;
+        buffer[count++] = (uint8_t)c;
+    }
+    return count;
+#else
+    // Host simulation: same stream from a pipe or terminal on stdin
+    static bool nonblocking = false;
+    if (!nonblocking) {
+        fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+        nonblocking = true;
+    }
+    ssize_t count = read(STDIN_FILENO, buffer, max_bytes);
+    return count > 0 ? (size_t)count : 0;
+#endif
+}
+
+// Move everything the host has sent into the FIFO, stamping arrival times
+static void usb_stream_poll(audio_source_t* src) {
+    uint8_t bytes[64];
+    
+    while (usb_stream_write - usb_stream_read < USB_STREAM_FIFO_SAMPLES) {
+        size_t space = (USB_STREAM_FIFO_SAMPLES - (usb_stream_write - usb_stream_read)) * 2;
+        size_t count = usb_stream_read_bytes(bytes, space < sizeof(bytes) ? space : sizeof(bytes));
+        if (count == 0) break;
+        src->stats.bytes_read += count;
+        
+        uint32_t now = time_us_32();
+        for (size_t i = 0; i < count; i++) {
+            if (usb_stream_low_byte < 0) {
+                usb_stream_low_byte = bytes[i];
+                continue;
+            }
+            uint32_t index = usb_stream_write & (USB_STREAM_FIFO_SAMPLES - 1);
+            if ((index & ((1 << USB_STREAM_STAMP_SHIFT) - 1)) == 0) {
+                usb_stream_stamps[index >> USB_STREAM_STAMP_SHIFT] = now;
+            }
+            usb_stream_fifo[index] = (int16_t)(usb_stream_low_byte | (bytes[i] << 8));
+            usb_stream_low_byte = -1;
+            usb_stream_write++;
+        }
+    }
+    
+    uint32_t fill = usb_stream_write - usb_stream_read;
+    if (!src->u.usb.xoff_sent && fill > USB_STREAM_FIFO_SAMPLES * 3 / 4) {
+        putchar_raw(XOFF);
+        src->u.usb.xoff_sent = true;
+        src->u.usb.xoff_count++;
+    } else if (src->u.usb.xoff_sent && fill < USB_STREAM_FIFO_SAMPLES / 4) {
+        putchar_raw(XON);
+        src->u.usb.xoff_sent = false;
+    }
+}
+
+// PI controller: FIFO fill error -> resampling ratio trim in ppm
+static void usb_stream_track_drift(audio_source_t* src, uint32_t fill) {
+    const int32_t target = USB_STREAM_FIFO_SAMPLES / 2;
+    int32_t error = (int32_t)fill - target;
+    
+    src->u.usb.fill_integral += error;
+    if (src->u.usb.fill_integral > target * 256) src->u.usb.fill_integral = target * 256;
+    if (src->u.usb.fill_integral < -target * 256) src->u.usb.fill_integral = -target * 256;
+    
+    int32_t adjust = error + (error >> 2) + (src->u.usb.fill_integral >> 10);
+    if (adjust > USB_STREAM_MAX_ADJUST_PPM) adjust = USB_STREAM_MAX_ADJUST_PPM;
+    if (adjust < -USB_STREAM_MAX_ADJUST_PPM) adjust = -USB_STREAM_MAX_ADJUST_PPM;
+    
+    src->u.usb.adjust_ppm = adjust;
+    src->u.usb.resampler.step = (1u << 16) + (int32_t)(((int64_t)adjust << 16) / 1000000);
+}
+
+static bool usb_stream_source_open(audio_source_t* src, const char* location) {
+    (void)location;
+    src->sample_rate = config.audio_sample_rate;
+    src->num_channels = 1;
+    src->total_frames = 0;  // Endless
+    
+    memset(&src->u.usb, 0, sizeof(src->u.usb));
+    src->u.usb.latency_min_us = UINT32_MAX;
+    resampler_init(&src->u.usb.resampler, config.audio_sample_rate, config.audio_sample_rate);
+    src->u.usb.resampler.history = 0;
+    
+    usb_stream_write = usb_stream_read = 0;
+    usb_stream_low_byte = -1;
+    usb_stream_buffering = true;
+    
+    printf("USB stream: send raw s16le mono PCM at %d Hz; honour XON/XOFF\n",
+           config.audio_sample_rate);
+    return true;
+}
+
+static const int16_t* usb_stream_source_read_block(audio_source_t* src, uint32_t max_frames,
+                                                   uint32_t* frames) {
+    uint32_t out_capacity = (max_frames < BUFFER_SIZE) ? max_frames : BUFFER_SIZE;
+    usb_stream_poll(src);
+    
+    uint32_t fill = usb_stream_write - usb_stream_read;
+    usb_stream_track_drift(src, fill);
+    uint32_t needed = resampler_max_input(&src->u.usb.resampler, out_capacity);
+    
+    // Starved: hold silence (the carrier keeps running) until half full again
+    if (usb_stream_buffering || fill < needed) {
+        if (!usb_stream_buffering) {
+            src->u.usb.underruns++;
+            usb_stream_buffering = true;
+        }
+        if (fill >= USB_STREAM_FIFO_SAMPLES / 2) {
+            usb_stream_buffering = false;
+            src->u.usb.fill_integral = 0;
         } else {
-            f_lseek(file, f_tell(file) + chunk_size);
+            memset(src->u.usb.pcm, 0, out_capacity * sizeof(int16_t));
+            *frames = out_capacity;
+            return src->u.usb.pcm;
         }
     }
     
-    if (config.verbose_analysis) {
-        printf("WAV File Info:\n");
-        printf("- Sample Rate: %d Hz\n", header->sample_rate);
-        printf("- Channels: %d\n", header->num_channels);
-        printf("- Bit Depth: %d bits\n", header->bits_per_sample);
-        printf("- Duration: %.1f seconds\n", 
-               (float)header->data_size / header->byte_rate);
+    // Drain from the FIFO, measuring how long each stamped sample waited
+    uint32_t now = time_us_32();
+    for (uint32_t i = 0; i < needed; i++) {
+        uint32_t index = usb_stream_read & (USB_STREAM_FIFO_SAMPLES - 1);
+        if ((index & ((1 << USB_STREAM_STAMP_SHIFT) - 1)) == 0) {
+            uint32_t latency = now - usb_stream_stamps[index >> USB_STREAM_STAMP_SHIFT];
+            src->u.usb.latency_total_us += latency;
+            src->u.usb.latency_count++;
+            if (latency < src->u.usb.latency_min_us) src->u.usb.latency_min_us = latency;
+            if (latency > src->u.usb.latency_max_us) src->u.usb.latency_max_us = latency;
+        }
+        src->u.usb.input[i] = usb_stream_fifo[index];
+        usb_stream_read++;
+    }
+    
+    *frames = resampler_process(&src->u.usb.resampler, src->u.usb.input, needed,
+                                src->u.usb.pcm);
+    return src->u.usb.pcm;
+}
+
+static bool usb_stream_source_rewind(audio_source_t* src) {
+    (void)src;
+    return true;  // Live stream: nothing to rewind
+}
+
+static void usb_stream_source_close(audio_source_t* src) {
+    if (src->u.usb.xoff_sent) {
+        putchar_raw(XON);  // Never leave the host blocked
+        src->u.usb.xoff_sent = false;
+    }
+}
+
+static void usb_stream_report(const audio_source_t* src) {
+    // Samples still queued between core 0 and the PIO after leaving the FIFO
+    float downstream_ms = (BUFFER_SIZE * 3) * 1000.0f / config.audio_sample_rate;
+    
+    printf("- USB stream: %d underruns, %d XOFFs, drift trim %+d ppm\n",
+           src->u.usb.underruns, src->u.usb.xoff_count, src->u.usb.adjust_ppm);
+    if (src->u.usb.latency_count > 0) {
+        printf("- Host->pipeline latency: %.1f ms avg, %.1f min, %.1f max (+ up to %.1f ms to PIO)\n",
+               src->u.usb.latency_total_us / 1000.0f / src->u.usb.latency_count,
+               src->u.usb.latency_min_us / 1000.0f, src->u.usb.latency_max_us / 1000.0f,
+               downstream_ms);
+    }
+}
+
+static const audio_source_ops_t audio_source_backends[] = {
+    [AUDIO_SOURCE_SD] = {
+        "SD card", sd_source_open, sd_source_read_block, sd_source_rewind, sd_source_close
+    },
+    [AUDIO_SOURCE_XIP_FLASH] = {
+        "XIP flash", xip_source_open, xip_source_read_block, xip_source_rewind, xip_source_close
+    },
+    [AUDIO_SOURCE_RAM_LOOP] = {
+        "RAM loop", ram_loop_source_open, ram_loop_source_read_block,
+        ram_loop_source_rewind, ram_loop_source_close
+    },
+    [AUDIO_SOURCE_TEST_SIGNAL] = {
+        "Test signal", test_source_open, test_source_read_block,
+        test_source_rewind, test_source_close
+    },
+    [AUDIO_SOURCE_USB_STREAM] = {
+        "USB stream", usb_stream_source_open, usb_stream_source_read_block,
+        usb_stream_source_rewind, usb_stream_source_close
+    }
+};
+
+static bool audio_source_needs_sd(audio_source_type_t type) {
+    return type == AUDIO_SOURCE_SD || type == AUDIO_SOURCE_RAM_LOOP;
+}
+
+bool audio_source_open(audio_source_t* src, audio_source_type_t type, const char* location) {
+    src->ops = &audio_source_backends[type];
+    src->type = type;
+    src->is_open = false;
+    memset(&src->stats, 0, sizeof(src->stats));
+    
+    if (!src->ops->open(src, location)) return false;
+    
+    src->is_open = true;
+    return true;
+}
+
+// Read the next block of up to max_frames frames, updating throughput counters
+const int16_t* audio_source_read(audio_source_t* src, uint32_t max_frames, uint32_t* frames) {
+    uint64_t start = time_us_64();
+    const int16_t* block = src->ops->read_block(src, max_frames, frames);
+    uint32_t elapsed = (uint32_t)(time_us_64() - start);
+    
+    src->stats.busy_us += elapsed;
+    if (elapsed > src->stats.max_block_us) src->stats.max_block_us = elapsed;
+    if (*frames > 0) {
+        src->stats.blocks_delivered++;
+        src->stats.frames_delivered += *frames;
+    }
+    return block;
+}
+
+bool audio_source_rewind(audio_source_t* src) {
+    src->stats.rewinds++;
+    return src->ops->rewind(src);
+}
+
+void audio_source_close(audio_source_t* src) {
+    if (!src->is_open) return;
+    src->ops->close(src);
+    src->is_open = false;
+}
+
+void audio_source_report(const audio_source_t* src) {
+    const audio_source_stats_t* stats = &src->stats;
+    float busy_s = stats->busy_us / 1000000.0f;
+    
+    printf("Audio source (%s):\n", src->ops->name);
+    printf("- Blocks: %d, frames: %llu, rewinds: %d\n", stats->blocks_delivered,
+           (unsigned long long)stats->frames_delivered, stats->rewinds);
+    printf("- Storage read: %llu bytes\n", (unsigned long long)stats->bytes_read);
+    if (busy_s > 0.0f) {
+        printf("- Throughput: %.1f kframes/s, %.1f KB/s while busy\n",
+               stats->frames_delivered / busy_s / 1000.0f,
+               stats->bytes_read / busy_s / 1024.0f);
+    }
+    if (stats->blocks_delivered > 0) {
+        printf("- Read time: %llu us avg, %d us max per block\n",
+               (unsigned long long)(stats->busy_us / stats->blocks_delivered),
+               stats->max_block_us);
+    }
+    if (src->type == AUDIO_SOURCE_USB_STREAM) {
+        usb_stream_report(src);
+    }
+}
+
+// ============================================================================
+// PLAYLIST
+// ============================================================================
+
+static char playlist_entries[PLAYLIST_MAX_ENTRIES][PLAYLIST_MAX_PATH];
+static uint32_t playlist_length = 0;
+static uint32_t playlist_position = 0;   // Next entry to open
+static bool playlist_repeat = false;
+
+static bool has_wav_extension(const char* name) {
+    size_t len = strlen(name);
+    return len > 4 && strcasecmp(name + len - 4, ".wav") == 0;
+}
+
+static void playlist_add(const char* directory, const char* name) {
+    if (playlist_length >= PLAYLIST_MAX_ENTRIES) return;
+    
+    char* entry = playlist_entries[playlist_length];
+    if (directory && directory[0] && name[0] != '/') {
+        snprintf(entry, PLAYLIST_MAX_PATH, "%s/%s", directory, name);
+    } else {
+        snprintf(entry, PLAYLIST_MAX_PATH, "%s", name);
+    }
+    playlist_length++;
+}
+
+static int compare_playlist_entries(const void* a, const void* b) {
+    return strcmp((const char*)a, (const char*)b);
+}
+
+// Entries are paths relative to the M3U file's directory unless absolute
+static bool playlist_load_m3u(const char* path) {
+    FIL file;
+    if (f_open(&file, path, FA_READ) != FR_OK) {
+        printf("Error: Cannot open playlist '%s'\n", path);
+        return false;
+    }
+    
+    char directory[PLAYLIST_MAX_PATH];
+    snprintf(directory, sizeof(directory), "%s", path);
+    char* slash = strrchr(directory, '/');
+    if (slash) {
+        *slash = '\0';
+    } else {
+        directory[0] = '\0';
+    }
+    
+    char line[PLAYLIST_MAX_PATH];
+    while (f_gets(line, sizeof(line), &file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+        playlist_add(directory, line);
+    }
+    f_close(&file);
+    return true;
+}
+
+// Directory scan: every visible *.wav file, in name order
+static bool playlist_load_directory(const char* path) {
+    DIR dir;
+    FILINFO info;
+    
+    if (f_opendir(&dir, path) != FR_OK) {
+        printf("Error: Cannot open playlist directory '%s'\n", path);
+        return false;
+    }
+    
+    while (f_readdir(&dir, &info) == FR_OK && info.fname[0] != '\0') {
+        if (info.fattrib & (AM_DIR | AM_HID)) continue;
+        if (!has_wav_extension(info.fname)) continue;
+        playlist_add(path, info.fname);
+    }
+    f_closedir(&dir);
+    
+    qsort(playlist_entries, playlist_length, PLAYLIST_MAX_PATH, compare_playlist_entries);
+    return true;
+}
+
+bool playlist_load() {
+    playlist_length = 0;
+    playlist_position = 0;
+    
+    if (config.playlist == NULL || config.audio_source != AUDIO_SOURCE_SD) {
+        // Single track: the configured file (ignored by storage-less sources)
+        playlist_add(NULL, config.wav_filename);
+        playlist_repeat = false;
+        return true;
+    }
+    
+    size_t len = strlen(config.playlist);
+    bool ok = (len > 4 && strcasecmp(config.playlist + len - 4, ".m3u") == 0)
+              ? playlist_load_m3u(config.playlist)
+              : playlist_load_directory(config.playlist);
+    if (!ok) return false;
+    
+    if (playlist_length == 0) {
+        printf("Error: Playlist '%s' has no tracks\n", config.playlist);
+        return false;
+    }
+    
+    playlist_repeat = true;  // Continuous operation until the time limit
+    printf("Playlist: %d tracks from %s\n", playlist_length, config.playlist);
+    return true;
+}
+
+// Open the next playable entry and prime its first block. Unreadable
+// entries are skipped; returns false when the playlist is exhausted.
+static bool playlist_open_next(audio_source_t* src, const int16_t** primed, uint32_t* primed_frames) {
+    for (uint32_t attempt = 0; attempt < playlist_length; attempt++) {
+        if (playlist_position >= playlist_length) {
+            if (!playlist_repeat) return false;
+            playlist_position = 0;
+        }
+        
+        const char* location = playlist_entries[playlist_position++];
+        if (!audio_source_open(src, config.audio_source, location)) continue;
+        
+        *primed = audio_source_read(src, BUFFER_SIZE, primed_frames);
+        if (*primed_frames > 0) return true;
+        
+        audio_source_close(src);
     }
-    
-    return true;
+    return false;
 }
 
 // ============================================================================
@@ -904,107 +4599,769 @@ bool read_wav_header(FIL* file, wav_header_t* header) {
 
 void core1_signal_processing() {
     if (config.verbose_analysis) {
-        printf("Core 1: Starting real-time signal processing\n");
+        log_push(LOG_CORE1_START, 0, 0, 0);
     }
     
+    setup_modulation_dma();  // DMA IRQ lands on this core
+    governor_apply(governor.level);
+#if STAGE_PROFILING
+    stage_clock_init();
+#endif
+    int fill_buffer = 0;
+    
     while (transmission_active) {
-        // Wait for buffer ready
-        while (!buffer_a_ready && !buffer_b_ready && transmission_active) {
-            sleep_us(100);
+        // Sleep until core 0 publishes an envelope block
+        uint64_t wait_start = time_us_64();
+        if (pipeline_tail == pipeline_head && transmission_active) {
+            while (pipeline_tail == pipeline_head && transmission_active) {
+                __wfe();
+            }
+            record_wake_latency(WAKE_CORE1_BLOCK_READY);
+        }
+        
+        // Sleep until the DMA engine releases the buffer we fill next
+        if (modulation_buffer_full[fill_buffer] && transmission_active) {
+            while (modulation_buffer_full[fill_buffer] && transmission_active) {
+                __wfe();
+            }
+            record_wake_latency(WAKE_CORE1_DMA_DONE);
         }
+        uint64_t work_start = time_us_64();
+        core_wait_us[1] += work_start - wait_start;
         
         if (!transmission_active) break;
         
-        int16_t* audio_buffer;
-        uint32_t* mod_buffer;
+        if (retune_pending) apply_retune(fill_buffer);
         
-        if (use_buffer_a && buffer_a_ready) {
-            audio_buffer = audio_buffer_a;
-            mod_buffer = modulation_buffer_a;
-            buffer_a_ready = false;
-        } else if (!use_buffer_a && buffer_b_ready) {
-            audio_buffer = audio_buffer_b;
-            mod_buffer = modulation_buffer_b;
-            buffer_b_ready = false;
-        } else {
-            continue;
-        }
+        __dmb();  // Block contents are visible before we read them
+        const pipeline_block_t* block = &pipeline_blocks[pipeline_tail & (PIPELINE_DEPTH - 1)];
+        uint32_t* mod_buffer = modulation_buffers[fill_buffer];
         
-        // Process audio buffer
-        for (int i = 0; i < BUFFER_SIZE; i++) {
-            uint32_t modulated_sample = generate_am_signal(audio_buffer[i]);
+        // RF-rate stage: NCO, modulation, filtering, output formatting
+        bool packed = samples_per_word(&config) > 1;
+        bool multiphase = config.signal_mode == SIGNAL_MODE_MULTIPHASE;
+        bool stereo = config.signal_mode == SIGNAL_MODE_CQAM;
+        bool sideband = config.signal_mode == SIGNAL_MODE_USB ||
+                        config.signal_mode == SIGNAL_MODE_LSB;
+        bool multi = config.signal_mode == SIGNAL_MODE_MULTICARRIER;
+        bool fine = config.signal_mode == SIGNAL_MODE_FINE_PWM;
+        PROFILE_BLOCK_BEGIN();
+        PROFILE_MARK();
+        for (uint32_t i = 0; i < block->count; i++) {
+            if (multi) {
+                // Every station's NCO, summed and requantised for the ladder
+                uint16_t envelopes[MULTICARRIER_MAX];
+                envelopes[0] = block->envelope[i];
+                for (uint32_t k = 1; k < multicarrier_count; k++) {
+                    envelopes[k] = block->station_envelope[k - 1][i];
+                }
+                mod_buffer[i] = multicarrier_word(&multicarrier, envelopes, multicarrier_count);
+                PROFILE_LAP(STAGE_MODULATE);
+                continue;
+            }
+            if (packed) {
+                // NCO, noise shaping and packing in one: bitstream or DAC codes
+                mod_buffer[i] = packed_word(&sigma_delta, block->envelope[i]);
+                PROFILE_LAP(STAGE_MODULATE);
+                continue;
+            }
+            if (multiphase) {
+                // One table lookup: the phased outputs cancel the harmonics
+                mod_buffer[i] = multiphase_word(block->envelope[i], i);
+                PROFILE_LAP(STAGE_MODULATE);
+                continue;
+            }
+            if (stereo) {
+                // Trigonometry was done on core 0: one lookup and an add
+                mod_buffer[i] = cqam_word(&cqam, block->envelope[i], block->phase[i]);
+                PROFILE_LAP(STAGE_MODULATE);
+                continue;
+            }
+            if (fine) {
+                // Arcsine lookup and the width noise shaper, no NCO
+                mod_buffer[i] = fine_pwm_word(&fine_pwm, block->envelope[i]);
+                PROFILE_LAP(STAGE_MODULATE);
+                continue;
+            }
             
-            // Apply filtering if enabled
-            if (config.filter_mode == FILTER_MODE_BANDPASS_IIR) {
+            uint32_t modulated_sample = sideband ?
+                generate_ssb_signal(block->envelope[i], block->quadrature[i]) :
+                generate_am_signal(block->envelope[i]);
+            PROFILE_LAP(STAGE_MODULATE);
+            
+            // Apply filtering if enabled (IIR and elliptic share the cascade)
+            if (active_iir_sections > 0) {
                 float sample = modulated_sample / 4095.0f;
-                for (int j = 0; j < num_filter_sections; j++) {
+                for (int j = 0; j < active_iir_sections; j++) {
                     sample = process_biquad(&filter_sections[j], sample);
                 }
                 modulated_sample = (uint32_t)(sample * 4095);
+                PROFILE_LAP(STAGE_FILTER);
             }
             
             // Convert to PIO format
-            uint32_t pio_data = convert_to_pio_timing(modulated_sample);
-            mod_buffer[i] = pio_data;
+            mod_buffer[i] = config.noise_shaping ?
+                            shaped_pio_timing(&requantiser, modulated_sample) :
+                            convert_to_pio_timing(modulated_sample);
+            PROFILE_LAP(STAGE_PIO_FORMAT);
         }
+        uint32_t count = block->count;
+        PROFILE_COMMIT(STAGE_MODULATE);
+        if (active_iir_sections > 0) PROFILE_COMMIT(STAGE_FILTER);
+        PROFILE_COMMIT(STAGE_PIO_FORMAT);
         
-        // Send to PIO via DMA (simplified here - feed directly to PIO)
-        for (int i = 0; i < BUFFER_SIZE && transmission_active; i++) {
-            while (pio_sm_is_tx_fifo_full(pio, sm)) {
-                sleep_us(1);
-            }
-            pio_sm_put(pio, sm, mod_buffer[i]);
-        }
+        // Envelope block no longer needed: hand it back to core 0
+        __dmb();
+        pipeline_tail = pipeline_tail + 1;
+        signal_event(WAKE_CORE0_SLOT_FREE);
+        
+        // DMA streams the buffer to the PIO FIFO, paced by its DREQ
+        PROFILE_START(queue_start);
+        queue_modulation_buffer(fill_buffer);
+        PROFILE_END(STAGE_DMA_QUEUE, queue_start);
+        fill_buffer ^= 1;
         
-        samples_processed += BUFFER_SIZE;
+        governor_update((uint32_t)(time_us_64() - work_start));
+        
+        samples_processed += count;
         
         // Monitoring
         monitor_transmission();
     }
     
+    stop_modulation_dma();
+    
     if (config.verbose_analysis) {
-        printf("Core 1: Signal processing stopped\n");
+        log_push(LOG_CORE1_STOP, 0, 0, 0);
     }
+    core1_stopped = true;
+    __sev();
 }
 
-// Convert amplitude to PIO timing
-uint32_t convert_to_pio_timing(uint32_t amplitude) {
-    uint32_t base_period = 64;  // Base timing period
-    uint32_t high_time = (amplitude * base_period) / 4096;
-    uint32_t low_time = base_period - high_time;
+// ============================================================================
+// PERSISTENT CONFIGURATION
+// ============================================================================
+//
+// The shell's "persist" command stores the configuration, shell profiles
+// and the derived tables (waveform LUT, filter coefficients, pre-distortion
+// table) in the last PERSIST_FLASH_BYTES of flash. When a valid image is present,
+// boot skips the USB wait, the prompts and the table generation, and
+// starts transmitting at once. Layout (page aligned, programmed straight
+// from the live tables):
+//   +0      header page(s): persisted_header_t
+//   +4096   waveform_lut
+//   +20480  active FIR bank
+
+#define PERSIST_MAGIC 0x58544D41        // "AMTX"
+#define PERSIST_VERSION 8               // Bump when any persisted layout changes
+#define PERSIST_HEADER_BYTES 4096
+#define PERSIST_LUT_OFFSET PERSIST_HEADER_BYTES
+#define PERSIST_FIR_OFFSET (PERSIST_LUT_OFFSET + sizeof(waveform_lut))
+#define PERSIST_FIR_BYTES ((sizeof(fir_banks[0]) + FLASH_PAGE_SIZE - 1) & ~(FLASH_PAGE_SIZE - 1))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t crc32;               // Over the rest of the header, LUT and FIR bank
+    clock_plan_t clock_plan;      // Applied as saved: no search at boot
+    transmitter_config_t config;
+    char wav_filename[PLAYLIST_MAX_PATH];
+    char playlist[PLAYLIST_MAX_PATH];
+    uint8_t num_filter_sections;
+    uint8_t fir_length;
+    biquad_section_t filter_sections[4];
+    dpd_table_t dpd_table;
+    bool dpd_table_fitted;
+    shell_profile_t profiles[SHELL_PROFILE_SLOTS];
+} persisted_header_t;
+
+_Static_assert(sizeof(persisted_header_t) <= PERSIST_HEADER_BYTES, "persisted header too large");
+_Static_assert(PERSIST_FIR_OFFSET + PERSIST_FIR_BYTES <= PERSIST_FLASH_BYTES, "persist area too small");
+
+static union {
+    persisted_header_t header;
+    uint8_t bytes[PERSIST_HEADER_BYTES];
+} persist_page;
+
+static char persist_wav_filename[PLAYLIST_MAX_PATH];
+static char persist_playlist[PLAYLIST_MAX_PATH];
+static bool persist_tables_restored = false;  // Consumed by prepare_transmission
+static bool safety_confirmed = false;         // Only confirmed setups may auto-start
+
+// CRC-32 (IEEE), nibble table: small and fast enough to check ~22 KB at boot
+static uint32_t crc32_update(uint32_t crc, const void* data, size_t length) {
+    static const uint32_t nibble_table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+        0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    const uint8_t* bytes = data;
     
-    if (high_time < 1) high_time = 1;
-    if (low_time < 1) low_time = 1;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static uint32_t persist_crc(const persisted_header_t* header, const void* lut, const void* fir) {
+    const size_t skip = offsetof(persisted_header_t, clock_plan);
+    uint32_t crc = crc32_update(0, (const uint8_t*)header + skip, sizeof(*header) - skip);
+    crc = crc32_update(crc, lut, sizeof(waveform_lut));
+    return crc32_update(crc, fir, sizeof(fir_banks[0]));
+}
+
+// Idle only (core 1 stopped): write the current state to flash
+bool persist_save() {
+    if (transmission_active) {
+        printf("Error: Stop transmission before saving to flash\n");
+        return false;
+    }
+    if (!safety_confirmed) {
+        printf("Error: Only a setup that passed the safety check can auto-start\n");
+        return false;
+    }
+    if (config.audio_source == AUDIO_SOURCE_USB_STREAM) {
+        // It never ends and owns the serial port, so the shell could not
+        // stop it or forget the image again
+        printf("Error: The USB stream source cannot auto-start\n");
+        return false;
+    }
     
-    return (high_time << 16) | low_time;
+    persisted_header_t* header = &persist_page.header;
+    memset(&persist_page, 0, sizeof(persist_page));
+    header->magic = PERSIST_MAGIC;
+    header->version = PERSIST_VERSION;
+    header->clock_plan = clock_plan;
+    header->config = config;
+    snprintf(header->wav_filename, sizeof(header->wav_filename), "%s", config.wav_filename);
+    if (config.playlist) {
+        snprintf(header->playlist, sizeof(header->playlist), "%s", config.playlist);
+    }
+    header->num_filter_sections = num_filter_sections;
+    header->fir_length = fir_length;
+    memcpy(header->filter_sections, filter_sections, sizeof(header->filter_sections));
+    header->dpd_table = dpd_table;
+    header->dpd_table_fitted = dpd_table_fitted;
+    memcpy(header->profiles, shell_profiles, sizeof(header->profiles));
+    header->crc32 = persist_crc(header, waveform_lut, fir_coefficients);
+    
+#if !PICO_ON_DEVICE
+    printf("Error: The host build has no flash to save to\n");
+    return false;
+#else
+    // Nothing may execute from flash while it is erased or programmed
+    multicore_reset_core1();
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(PERSIST_FLASH_OFFSET, PERSIST_FLASH_BYTES);
+    flash_range_program(PERSIST_FLASH_OFFSET, persist_page.bytes, PERSIST_HEADER_BYTES);
+    flash_range_program(PERSIST_FLASH_OFFSET + PERSIST_LUT_OFFSET,
+                        (const uint8_t*)waveform_lut, sizeof(waveform_lut));
+    flash_range_program(PERSIST_FLASH_OFFSET + PERSIST_FIR_OFFSET,
+                        (const uint8_t*)fir_coefficients, PERSIST_FIR_BYTES);
+    restore_interrupts(irq_state);
+    
+    printf("Configuration saved to flash; the next boot transmits immediately\n");
+    return true;
+#endif
+}
+
+// Idle only: invalidate the saved image so boot waits for USB again
+void persist_forget() {
+    if (transmission_active) {
+        printf("Error: Stop transmission first\n");
+        return;
+    }
+#if PICO_ON_DEVICE
+    multicore_reset_core1();
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(PERSIST_FLASH_OFFSET, FLASH_SECTOR_SIZE);  // Header only
+    restore_interrupts(irq_state);
+    printf("Saved configuration erased\n");
+#else
+    printf("Error: The host build has no flash to erase\n");
+#endif
+}
+
+// Boot: adopt a valid saved image. Returns false (nothing changed) if
+// there is none or it is corrupt.
+bool persist_restore() {
+#if PICO_ON_DEVICE
+    const uint8_t* image = (const uint8_t*)(XIP_BASE + PERSIST_FLASH_OFFSET);
+#else
+    static const uint8_t image[PERSIST_FLASH_BYTES];  // No flash: never a valid image
+#endif
+    const persisted_header_t* header = (const persisted_header_t*)image;
+    
+    if (header->magic != PERSIST_MAGIC || header->version != PERSIST_VERSION ||
+        header->crc32 != persist_crc(header, image + PERSIST_LUT_OFFSET,
+                                     image + PERSIST_FIR_OFFSET) ||
+        header->config.audio_source == AUDIO_SOURCE_USB_STREAM) {
+        return false;
+    }
+    
+    config = header->config;
+    snprintf(persist_wav_filename, sizeof(persist_wav_filename), "%s", header->wav_filename);
+    config.wav_filename = persist_wav_filename;
+    config.playlist = NULL;
+    if (header->playlist[0]) {
+        snprintf(persist_playlist, sizeof(persist_playlist), "%s", header->playlist);
+        config.playlist = persist_playlist;
+    }
+    
+    memcpy(waveform_lut, image + PERSIST_LUT_OFFSET, sizeof(waveform_lut));
+    memcpy(fir_coefficients, image + PERSIST_FIR_OFFSET, sizeof(fir_banks[0]));
+    memcpy(filter_sections, header->filter_sections, sizeof(header->filter_sections));
+    num_filter_sections = header->num_filter_sections;
+    fir_length = header->fir_length;
+    dpd_table = header->dpd_table;
+    dpd_table_fitted = header->dpd_table_fitted;
+    memcpy(shell_profiles, header->profiles, sizeof(shell_profiles));
+    clock_plan = header->clock_plan;
+    clock_plan_restored = true;
+    
+    persist_tables_restored = true;
+    safety_confirmed = true;  // Recorded when the image was saved
+    return true;
 }
 
 // ============================================================================
-// MAIN TRANSMISSION FUNCTION
+// COMMAND SHELL
 // ============================================================================
+//
+// Line-based shell on USB serial. Settings use the command-line option
+// names without the dashes ("frequency 1000000", "mode sine", "filter
+// bp-iir") and go through the same parser into a staged configuration.
+// While transmitting, carrier, depth, mode and filter changes are retuned
+// at the next block and monitoring flags apply at once; anything else
+// waits for "restart". Profiles are configuration snapshots held in RAM,
+// so loading one costs a struct copy and a retune.
 
-void transmit_wav_file() {
-    FIL wav_file;
-    wav_header_t header;
-    UINT bytes_read;
+#define SHELL_LINE_MAX 128
+#define SHELL_MAX_ARGS 8
+
+typedef enum {
+    SHELL_CONTINUE,
+    SHELL_START,                  // Idle shell: begin transmitting
+    SHELL_QUIT
+} shell_action_t;
+
+static transmitter_config_t shell_staged;
+static bool shell_staged_valid = false;
+static char shell_wav_filename[PLAYLIST_MAX_PATH];
+static char shell_playlist[PLAYLIST_MAX_PATH];
+static char shell_line[SHELL_LINE_MAX];
+static uint32_t shell_line_length = 0;
+static volatile bool restart_requested = false;
+
+// Parsed strings point into the line buffer: keep our own copies
+static void shell_own_strings(transmitter_config_t* cfg) {
+    if (cfg->wav_filename != shell_wav_filename) {
+        snprintf(shell_wav_filename, sizeof(shell_wav_filename), "%s", cfg->wav_filename);
+        cfg->wav_filename = shell_wav_filename;
+    }
+    if (cfg->playlist && cfg->playlist != shell_playlist) {
+        snprintf(shell_playlist, sizeof(shell_playlist), "%s", cfg->playlist);
+        cfg->playlist = shell_playlist;
+    }
+}
+
+static transmitter_config_t* shell_staged_config() {
+    if (!shell_staged_valid) {
+        shell_staged = config;
+        shell_own_strings(&shell_staged);
+        shell_staged_valid = true;
+    }
+    return &shell_staged;
+}
+
+// Main, before a (re)start: everything staged becomes the configuration
+void shell_commit_staged() {
+    if (shell_staged_valid) config = shell_staged;
+}
+
+static bool same_stations(const transmitter_config_t* a, const transmitter_config_t* b) {
+    if (a->station_count != b->station_count) return false;
+    for (uint32_t k = 0; k < a->station_count; k++) {
+        if (a->stations[k].frequency != b->stations[k].frequency ||
+            a->stations[k].depth != b->stations[k].depth ||
+            a->stations[k].tone_hz != b->stations[k].tone_hz) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Push staged settings to the running transmitter where that is possible
+static void shell_apply_live() {
+    const transmitter_config_t* staged = &shell_staged;
+    
+    if (!transmission_active) {
+        config = *staged;  // Core 1 is not running: nothing to coordinate
+        return;
+    }
     
-    printf("Opening WAV file: %s\n", config.wav_filename);
+    bool retune = staged->carrier_frequency != config.carrier_frequency ||
+                  staged->modulation_depth != config.modulation_depth ||
+                  staged->signal_mode != config.signal_mode ||
+                  staged->filter_mode != config.filter_mode ||
+                  staged->filter_bandwidth != config.filter_bandwidth ||
+                  staged->filter_order != config.filter_order ||
+                  staged->oversampling_rate != config.oversampling_rate;
+    if (retune && !retune_transmitter(staged)) {
+        printf("Retune not applied now; takes effect on restart\n");
+    }
     
-    FRESULT fr = f_open(&wav_file, config.wav_filename, FA_READ);
-    if (fr != FR_OK) {
-        printf("Error: Cannot open WAV file '%s' (error: %d)\n", config.wav_filename, fr);
+    // Read afresh on every use
+    config.verbose_analysis = staged->verbose_analysis;
+    config.spectrum_analysis = staged->spectrum_analysis;
+    config.harmonic_analysis = staged->harmonic_analysis;
+    config.enable_predistortion = staged->enable_predistortion;
+    config.enable_governor = staged->enable_governor;
+    config.noise_shaping = staged->noise_shaping;
+    config.enable_safety_limits = staged->enable_safety_limits;
+    config.transmission_time_limit = staged->transmission_time_limit;
+    
+    bool restart = staged->audio_source != config.audio_source ||
+                   strcmp(staged->wav_filename, config.wav_filename) != 0 ||
+                   (staged->playlist == NULL) != (config.playlist == NULL) ||
+                   (staged->playlist && strcmp(staged->playlist, config.playlist) != 0) ||
+                   staged->test_signal != config.test_signal ||
+                   staged->test_frequency != config.test_frequency ||
+                   staged->test_frequency2 != config.test_frequency2 ||
+                   staged->test_seed != config.test_seed ||
+                   staged->audio_sample_rate != config.audio_sample_rate;
+    if (restart) {
+        printf("Source changes take effect on restart\n");
+    }
+    if (staged->overclock_profile != config.overclock_profile ||
+        staged->sigma_delta_order != config.sigma_delta_order ||
+        staged->dac_bits != config.dac_bits ||
+        !same_stations(staged, &config)) {
+        printf("Clock profile, sigma-delta order, DAC width and station changes take effect "
+               "on restart\n");
+    }
+}
+
+static void shell_status() {
+    static const char* const mode_names[] = {
+        "simple", "square", "sigma", "sine", "predist", "oversample", "dac",
+        "multiphase", "cquam", "dsb", "usb", "lsb", "multi", "finepwm"
+    };
+    static const char* const filter_names[] = {
+        "none", "lowpass", "bp-iir", "bp-fir", "bp-ellip", "multiband"
+    };
+    
+    printf("%s on %.1f kHz, mode %s, %d%% depth, filter %s, source %s\n",
+           transmission_active ? "Transmitting" : "Idle",
+           config.carrier_frequency / 1000.0f, mode_names[config.signal_mode],
+           config.modulation_depth, filter_names[config.filter_mode],
+           audio_source_backends[config.audio_source].name);
+    printf("clk_sys %.1f MHz (profile %s)\n", clock_get_hz(clk_sys) / 1e6f,
+           overclock_profiles[config.overclock_profile].name);
+    for (uint32_t k = 0; k < config.station_count; k++) {
+        printf("Station %d: %.1f kHz, %d%% depth, %d Hz tone\n", k + 2,
+               config.stations[k].frequency / 1000.0f, config.stations[k].depth,
+               config.stations[k].tone_hz);
+    }
+    if (config.signal_mode == SIGNAL_MODE_PREDISTORTION || config.enable_predistortion) {
+        printf("Pre-distortion: %s table%s\n", dpd_table_fitted ? "fitted" : "built-in",
+               dpd_table_request[0] ? ", another one loads on restart" : "");
+    }
+    if (first_rf_us) {
+        printf("Carrier came up %.1f ms after boot\n", first_rf_us / 1000.0f);
+    }
+    if (transmission_active) {
+        printf("%d samples, %d underruns, DSP rung '%s' (load %d%%)\n",
+               samples_processed, underrun_count, quality_ladder[governor.level].name,
+               governor.load_pct);
+    }
+}
+
+static shell_profile_t* shell_find_profile(const char* name, bool allocate) {
+    shell_profile_t* free_slot = NULL;
+    for (int i = 0; i < SHELL_PROFILE_SLOTS; i++) {
+        if (strcmp(shell_profiles[i].name, name) == 0) return &shell_profiles[i];
+        if (!free_slot && shell_profiles[i].name[0] == '\0') free_slot = &shell_profiles[i];
+    }
+    return allocate ? free_slot : NULL;
+}
+
+static void shell_save_profile(const char* name) {
+    shell_profile_t* profile = shell_find_profile(name, true);
+    if (!profile) {
+        printf("Error: All %d profile slots in use\n", SHELL_PROFILE_SLOTS);
+        return;
+    }
+    
+    const transmitter_config_t* staged = shell_staged_config();
+    snprintf(profile->name, sizeof(profile->name), "%s", name);
+    profile->config = *staged;
+    snprintf(profile->wav_filename, sizeof(profile->wav_filename), "%s", staged->wav_filename);
+    profile->playlist[0] = '\0';
+    if (staged->playlist) {
+        snprintf(profile->playlist, sizeof(profile->playlist), "%s", staged->playlist);
+    }
+    printf("Profile '%s' saved\n", profile->name);
+}
+
+static void shell_load_profile(const char* name) {
+    const shell_profile_t* profile = shell_find_profile(name, false);
+    if (!profile) {
+        printf("Error: No profile '%s'\n", name);
         return;
     }
     
-    if (!read_wav_header(&wav_file, &header)) {
-        f_close(&wav_file);
+    uint64_t start = time_us_64();
+    shell_staged = profile->config;
+    shell_staged_valid = true;
+    snprintf(shell_wav_filename, sizeof(shell_wav_filename), "%s", profile->wav_filename);
+    shell_staged.wav_filename = shell_wav_filename;
+    if (profile->playlist[0]) {
+        snprintf(shell_playlist, sizeof(shell_playlist), "%s", profile->playlist);
+        shell_staged.playlist = shell_playlist;
+    } else {
+        shell_staged.playlist = NULL;
+    }
+    shell_apply_live();
+    printf("Profile '%s' loaded in %d us\n", name, (uint32_t)(time_us_64() - start));
+}
+
+static void shell_help() {
+    printf("Commands:\n");
+    printf("  status                  Show what is being transmitted\n");
+    printf("  start | stop | restart  Control transmission\n");
+    printf("  save NAME | load NAME   Store or recall a settings profile\n");
+    printf("  profiles                List stored profiles\n");
+    printf("  persist | forget        Save settings, profiles and tables to flash\n");
+    printf("                          for immediate boot, or erase them (idle only)\n");
+    printf("  file NAME               WAV file for the next start\n");
+    printf("  quit                    Leave the shell (when idle)\n");
+    printf("Any option without its dashes, e.g. 'frequency 1000000', 'mode sine',\n");
+    printf("'station 3AW', 'filter bp-iir', 'verbose'. 'usage' lists them all.\n");
+}
+
+static shell_action_t shell_execute(char* line) {
+    char* argv[SHELL_MAX_ARGS + 1];
+    int argc = 0;
+    argv[argc++] = "shell";
+    for (char* token = strtok(line, " \t"); token && argc < SHELL_MAX_ARGS;
+         token = strtok(NULL, " \t")) {
+        argv[argc++] = token;
+    }
+    argv[argc] = NULL;
+    if (argc < 2) return SHELL_CONTINUE;
+    
+    const char* command = argv[1];
+    if (strcmp(command, "help") == 0) {
+        shell_help();
+    } else if (strcmp(command, "usage") == 0) {
+        print_usage("");
+    } else if (strcmp(command, "status") == 0) {
+        shell_status();
+    } else if (strcmp(command, "start") == 0) {
+        if (!transmission_active) return SHELL_START;
+        printf("Already transmitting\n");
+    } else if (strcmp(command, "stop") == 0 || strcmp(command, "restart") == 0) {
+        if (transmission_active) {
+            restart_requested = (command[0] == 'r');
+            transmission_active = false;
+            __sev();
+        } else if (command[0] == 'r') {
+            return SHELL_START;
+        }
+    } else if (strcmp(command, "save") == 0 && argc == 3) {
+        shell_save_profile(argv[2]);
+    } else if (strcmp(command, "load") == 0 && argc == 3) {
+        shell_load_profile(argv[2]);
+    } else if (strcmp(command, "profiles") == 0) {
+        for (int i = 0; i < SHELL_PROFILE_SLOTS; i++) {
+            const shell_profile_t* profile = &shell_profiles[i];
+            if (profile->name[0] == '\0') continue;
+            printf("- %s: %.1f kHz, %s\n", profile->name,
+                   profile->config.carrier_frequency / 1000.0f,
+                   audio_source_backends[profile->config.audio_source].name);
+        }
+    } else if (strcmp(command, "persist") == 0) {
+        persist_save();
+    } else if (strcmp(command, "forget") == 0) {
+        persist_forget();
+    } else if (strcmp(command, "quit") == 0) {
+        if (!transmission_active) return SHELL_QUIT;
+        printf("Stop transmission first\n");
+    } else {
+        // Option: reuse the command-line parser on the staged configuration
+        static char option[SHELL_LINE_MAX];
+        if (strcmp(command, "file") == 0) {
+            memmove(&argv[1], &argv[2], sizeof(argv[0]) * (argc - 1));
+            argc--;
+        } else if (command[0] != '-') {
+            snprintf(option, sizeof(option), "--%s", command);
+            argv[1] = option;
+        }
+        
+        transmitter_config_t* staged = shell_staged_config();
+        transmitter_config_t previous = *staged;
+        optind = 0;  // Full getopt reset (glibc and newlib)
+        int result = parse_options(staged, argc, argv);
+        if (result < 0) {
+            *staged = previous;
+        } else if (result == 0) {
+            shell_own_strings(staged);
+            shell_apply_live();
+        }
+    }
+    return SHELL_CONTINUE;
+}
+
+// Core 0: consume whatever has arrived on USB serial without blocking
+shell_action_t shell_poll() {
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c == '\r' || c == '\n') {
+            if (shell_line_length == 0) continue;
+            shell_line[shell_line_length] = '\0';
+            shell_line_length = 0;
+            printf("\n");
+            
+            shell_action_t action = shell_execute(shell_line);
+            printf("> ");
+            if (action != SHELL_CONTINUE) return action;
+        } else if ((c == '\b' || c == 0x7F) && shell_line_length > 0) {
+            shell_line_length--;
+            printf("\b \b");
+        } else if (c >= ' ' && shell_line_length < SHELL_LINE_MAX - 1) {
+            shell_line[shell_line_length++] = c;
+            putchar(c);
+        }
+    }
+    return SHELL_CONTINUE;
+}
+
+// Between transmissions: returns true to start, false to quit
+bool shell_run_idle() {
+    printf("\nTransmitter idle. Type 'help' for commands, 'start' to transmit.\n> ");
+    for (;;) {
+        shell_action_t action = shell_poll();
+        if (action != SHELL_CONTINUE) return action == SHELL_START;
+        sleep_ms(10);
+    }
+}
+
+// ============================================================================
+// MAIN TRANSMISSION FUNCTION
+// ============================================================================
+
+// Audio-rate stage on core 0: turn mono samples (and in C-QUAM, the L-R
+// difference) into envelope and phase blocks and publish them to core 1.
+// Returns false once transmission stops.
+static bool queue_audio_samples(const int16_t* samples, const int16_t* difference,
+                                size_t count) {
+    while (count > 0) {
+        // Wait for a free block (ring full = core 1 is behind)
+        uint64_t wait_start = time_us_64();
+        if (pipeline_head - pipeline_tail >= PIPELINE_DEPTH) {
+            while (pipeline_head - pipeline_tail >= PIPELINE_DEPTH) {
+                if (!transmission_active) return false;
+                __wfe();
+            }
+            record_wake_latency(WAKE_CORE0_SLOT_FREE);
+        }
+        core_wait_us[0] += time_us_64() - wait_start;
+        
+        if (!transmission_active) return false;
+        
+        pipeline_block_t* block = &pipeline_blocks[pipeline_head & (PIPELINE_DEPTH - 1)];
+        size_t block_count = (count > BUFFER_SIZE) ? BUFFER_SIZE : count;
+        
+        for (size_t i = 0; i < block_count; i++) {
+            audio_rate_sample(block, i, samples[i], difference[i]);
+        }
+        // Pad short blocks with unmodulated carrier (C-QUAM: at the last phase)
+        int16_t pad_phase = (config.signal_mode == SIGNAL_MODE_CQAM && block_count) ?
+                            block->phase[block_count - 1] : 0;
+        for (size_t i = block_count; i < BUFFER_SIZE; i++) {
+            block->envelope[i] = ENVELOPE_UNITY;
+            block->phase[i] = pad_phase;
+        }
+        if (config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+            for (uint32_t k = 0; k < config.station_count; k++) {
+                for (size_t i = block_count; i < BUFFER_SIZE; i++) {
+                    block->station_envelope[k][i] = ENVELOPE_UNITY;
+                }
+            }
+        }
+        block->count = BUFFER_SIZE;
+        
+        __dmb();  // Publish contents before the index
+        pipeline_head = pipeline_head + 1;
+        signal_event(WAKE_CORE1_BLOCK_READY);
+        
+        samples += block_count;
+        difference += block_count;
+        count -= block_count;
+    }
+    return true;
+}
+
+// Percentage of wall time a core spent doing work rather than waiting
+static float core_utilisation(uint core) {
+    uint64_t elapsed = time_us_64() - pipeline_start_us;
+    if (elapsed == 0) return 0.0f;
+    return 100.0f * (1.0f - (float)core_wait_us[core] / elapsed);
+}
+
+// Collect output-rate samples into whole BUFFER_SIZE blocks so track
+// boundaries never insert padding into the stream
+static int16_t staged_block[BUFFER_SIZE];
+static int16_t staged_difference[BUFFER_SIZE];  // C-QUAM L-R; zero for mono sources
+static uint32_t staged_count = 0;
+
+static bool stage_audio_samples(const int16_t* samples, const int16_t* difference,
+                                uint32_t count) {
+    while (count > 0) {
+        uint32_t space = BUFFER_SIZE - staged_count;
+        uint32_t n = (count < space) ? count : space;
+        memcpy(&staged_block[staged_count], samples, n * sizeof(int16_t));
+        if (difference) {
+            memcpy(&staged_difference[staged_count], difference, n * sizeof(int16_t));
+            difference += n;
+        } else {
+            memset(&staged_difference[staged_count], 0, n * sizeof(int16_t));
+        }
+        staged_count += n;
+        samples += n;
+        count -= n;
+        
+        if (staged_count == BUFFER_SIZE) {
+            staged_count = 0;
+            if (!queue_audio_samples(staged_block, staged_difference, BUFFER_SIZE)) return false;
+        }
+    }
+    return true;
+}
+
+void transmit_audio() {
+    static audio_source_t sources[2];
+    static audio_resampler_t resampler;
+    static audio_resampler_t difference_resampler;  // C-QUAM L-R, in step with resampler
+    audio_source_t* current = &sources[0];
+    audio_source_t* next = &sources[1];
+    const int16_t* block;
+    uint32_t frames;
+    
+    printf("Opening audio source: %s\n", audio_source_backends[config.audio_source].name);
+    
+    if (!playlist_load() || !playlist_open_next(current, &block, &frames)) {
         return;
     }
     
-    // Sample rate conversion warning
-    if (header.sample_rate != config.audio_sample_rate) {
-        printf("Note: WAV sample rate (%d Hz) differs from config (%d Hz)\n",
-               header.sample_rate, config.audio_sample_rate);
+    // Sample rate conversion note
+    if (current->sample_rate != config.audio_sample_rate) {
+        printf("Note: Source sample rate (%d Hz) resampled to %d Hz\n",
+               current->sample_rate, config.audio_sample_rate);
     }
     
     printf("\nStarting transmission...\n");
@@ -1012,73 +5369,148 @@ void transmit_wav_file() {
     
     transmission_active = true;
     transmission_start_time = to_ms_since_boot(get_absolute_time());
+    pipeline_head = pipeline_tail = 0;
+    staged_count = 0;  // A stopped run may leave a partial block behind
+    core_wait_us[0] = core_wait_us[1] = 0;
+    pipeline_start_us = time_us_64();
+    samples_processed = 0;
+    core1_stopped = false;
+#if STAGE_PROFILING
+    stage_clock_init();
+#endif
     
-    // Launch Core 1 for signal processing
+    // Launch Core 1 once; it keeps running across every track change
+    multicore_reset_core1();  // Previous run's core 1 has returned
     multicore_launch_core1(core1_signal_processing);
     
-    // Main transmission loop (Core 0: File I/O)
-    static int16_t file_buffer[BUFFER_SIZE * 2];
-    uint32_t total_samples = header.data_size / (header.bits_per_sample / 8);
-    uint32_t samples_read = 0;
+    // Main transmission loop (Core 0: audio source I/O)
+    static int16_t mono_buffer[BUFFER_SIZE];
+    static int16_t resampled_buffer[BUFFER_SIZE];
+    static int16_t difference_buffer[BUFFER_SIZE];
+    static int16_t resampled_difference[BUFFER_SIZE];
+    resampler_init(&resampler, current->sample_rate, config.audio_sample_rate);
+    resampler_init(&difference_resampler, current->sample_rate, config.audio_sample_rate);
+    resampler.history = 0;
+    difference_resampler.history = 0;
     
-    while (samples_read < total_samples && transmission_active) {
-        // Read chunk from file
-        size_t bytes_to_read = sizeof(file_buffer);
-        if (header.num_channels == 2) bytes_to_read /= 2;
-        
-        fr = f_read(&wav_file, file_buffer, bytes_to_read, &bytes_read);
-        if (fr != FR_OK || bytes_read == 0) break;
-        
-        size_t samples_in_chunk = bytes_read / sizeof(int16_t);
+    bool next_ready = false;
+    const int16_t* next_block = NULL;
+    uint32_t next_frames = 0;
+    uint32_t tracks_played = 1;
+    uint32_t samples_sent = 0;
+    uint32_t next_progress = config.audio_sample_rate * 10;
+    
+    while (transmission_active) {
+        uint64_t iteration_start = time_us_64();
+        uint64_t iteration_wait = core_wait_us[0];
+        uint32_t iteration_samples = samples_sent;
         
-        // Convert stereo to mono if needed
-        if (header.num_channels == 2) {
-            for (size_t i = 0; i < samples_in_chunk / 2; i++) {
-                file_buffer[i] = (file_buffer[i * 2] + file_buffer[i * 2 + 1]) / 2;
+        if (frames == 0) {
+            // Track finished: swap in the prefetched source. PIO, DMA and
+            // core 1 are untouched, so the carrier runs straight through.
+            audio_source_close(current);
+            if (!next_ready &&
+                !(next_ready = playlist_open_next(next, &next_block, &next_frames))) {
+                break;
+            }
+            
+            audio_source_t* finished = current;
+            current = next;
+            next = finished;
+            block = next_block;
+            frames = next_frames;
+            next_ready = false;
+            
+            resampler_init(&resampler, current->sample_rate, config.audio_sample_rate);
+            resampler_init(&difference_resampler, current->sample_rate, config.audio_sample_rate);
+            tracks_played++;
+            if (config.verbose_analysis) {
+                printf("Track %d: %s (%d Hz, %d ch)\n", tracks_played,
+                       playlist_entries[(playlist_position + playlist_length - 1) % playlist_length],
+                       current->sample_rate, current->num_channels);
             }
-            samples_in_chunk /= 2;
         }
         
-        // Wait for available buffer
-        while ((use_buffer_a && buffer_a_ready) || (!use_buffer_a && buffer_b_ready)) {
-            if (!transmission_active) break;
-            sleep_ms(10);
+        // Convert stereo to mono if needed; C-QUAM also keeps (L-R) / 2
+        const int16_t* difference = NULL;
+        if (current->num_channels == 2) {
+            for (uint32_t i = 0; i < frames; i++) {
+                mono_buffer[i] = (block[i * 2] + block[i * 2 + 1]) / 2;
+            }
+            if (config.signal_mode == SIGNAL_MODE_CQAM) {
+                for (uint32_t i = 0; i < frames; i++) {
+                    difference_buffer[i] = (block[i * 2] - block[i * 2 + 1]) / 2;
+                }
+                difference = difference_buffer;
+            }
+            block = mono_buffer;
         }
         
-        if (!transmission_active) break;
-        
-        // Fill buffer
-        size_t samples_to_copy = (samples_in_chunk > BUFFER_SIZE) ? BUFFER_SIZE : samples_in_chunk;
-        
-        if (use_buffer_a) {
-            memcpy(audio_buffer_a, file_buffer, samples_to_copy * sizeof(int16_t));
-            if (samples_to_copy < BUFFER_SIZE) {
-                memset(&audio_buffer_a[samples_to_copy], 0, 
-                       (BUFFER_SIZE - samples_to_copy) * sizeof(int16_t));
+        // Resample in chunks that fit one output block (primed blocks are
+        // read before the track's rate is known)
+        bool staged = true;
+        for (uint32_t done = 0; done < frames && staged; ) {
+            uint32_t chunk = resampler_max_input(&resampler, BUFFER_SIZE);
+            if (chunk > frames - done) chunk = frames - done;
+            PROFILE_START(resample_start);
+            uint32_t produced = resampler_process(&resampler, block + done, chunk,
+                                                  resampled_buffer);
+            if (difference) {
+                resampler_process(&difference_resampler, difference + done, chunk,
+                                  resampled_difference);
             }
-            buffer_a_ready = true;
-        } else {
-            memcpy(audio_buffer_b, file_buffer, samples_to_copy * sizeof(int16_t));
-            if (samples_to_copy < BUFFER_SIZE) {
-                memset(&audio_buffer_b[samples_to_copy], 0, 
-                       (BUFFER_SIZE - samples_to_copy) * sizeof(int16_t));
-            }
-            buffer_b_ready = true;
+            PROFILE_END(STAGE_RESAMPLE, resample_start);
+            staged = stage_audio_samples(resampled_buffer, difference ? resampled_difference : NULL,
+                                         produced);
+            samples_sent += produced;
+            done += chunk;
         }
+        if (!staged) break;
         
-        use_buffer_a = !use_buffer_a;
-        samples_read += samples_in_chunk;
+        // Prefetch: open, parse and prime the next track while this one drains
+        if (!next_ready && current->total_frames > 0 &&
+            current->total_frames - current->stats.frames_delivered <= PLAYLIST_PREFETCH_FRAMES &&
+            (playlist_position < playlist_length || playlist_repeat)) {
+            next_ready = playlist_open_next(next, &next_block, &next_frames);
+        }
         
         // Progress update
-        if (config.verbose_analysis && (samples_read % (header.sample_rate * 10) == 0)) {
-            printf("Progress: %d/%d seconds\n", 
-                   samples_read / header.sample_rate,
-                   total_samples / header.sample_rate);
+        if (config.verbose_analysis && samples_sent >= next_progress) {
+            next_progress += config.audio_sample_rate * 10;
+            printf("Progress: %d seconds, track %d\n",
+                   samples_sent / config.audio_sample_rate, tracks_played);
+        }
+        
+        telemetry_drain();
+        if (config.audio_source != AUDIO_SOURCE_USB_STREAM) {
+            shell_poll();  // USB serial carries audio in usb mode
+        }
+        PROFILE_START(decode_start);
+        block = audio_source_read(current, BUFFER_SIZE, &frames);
+        PROFILE_END(STAGE_DECODE, decode_start);
+        
+        // Busy time per output block, for the load governor on core 1
+        uint32_t produced = samples_sent - iteration_samples;
+        if (produced > 0) {
+            uint64_t busy = time_us_64() - iteration_start - (core_wait_us[0] - iteration_wait);
+            core0_block_busy_us = (uint32_t)(busy * BUFFER_SIZE / produced);
         }
     }
     
+    // Flush the final partial block (zero padded)
+    if (staged_count > 0 && transmission_active) {
+        queue_audio_samples(staged_block, staged_difference, staged_count);
+        staged_count = 0;
+    }
+    
     transmission_active = false;
-    f_close(&wav_file);
+    __sev();  // Wake core 1 so it sees the stop
+    while (!core1_stopped) {
+        __wfe();
+    }
+    telemetry_drain();
+    audio_source_close(current);
+    if (next_ready) audio_source_close(next);
     
     printf("\nTransmission complete!\n");
     if (config.verbose_analysis) {
@@ -1087,6 +5519,23 @@ void transmit_wav_file() {
         printf("- Final THD estimate: %.3f%%\n", measured_thd);
         printf("- Transmission time: %d seconds\n", 
                (to_ms_since_boot(get_absolute_time()) - transmission_start_time) / 1000);
+        if (adpcm_frames_decoded > 0) {
+            float cycles_per_sample = (float)adpcm_decode_time_us *
+                                      (clock_get_hz(clk_sys) / 1000000.0f) /
+                                      adpcm_frames_decoded;
+            printf("- ADPCM decode: %d blocks, %d frames, %.1f cycles/sample (core 0)\n",
+                   adpcm_blocks_decoded, adpcm_frames_decoded, cycles_per_sample);
+        }
+        printf("- Core utilisation: core 0 (audio rate) %.1f%%, core 1 (RF rate) %.1f%%\n",
+               core_utilisation(0), core_utilisation(1));
+        printf("- Tracks played: %d\n", tracks_played);
+        report_governor();
+        report_wake_latency();
+        report_underruns();
+#if STAGE_PROFILING
+        report_stage_profile(stage_stats);  // Core 1 has stopped: read it live
+#endif
+        audio_source_report(current);
     }
 }
 
@@ -1095,7 +5544,7 @@ void transmit_wav_file() {
 // ============================================================================
 
 bool init_sd_card() {
-    FATFS fs;
+    static FATFS fs;  // FatFs keeps a pointer to the work area while mounted
     FRESULT fr = f_mount(&fs, "", 1);
     
     if (fr != FR_OK) {
@@ -1113,6 +5562,109 @@ bool init_sd_card() {
     return true;
 }
 
+// SD card, filters and PIO for the current configuration. Called at boot
+// and again before every shell-initiated start.
+bool prepare_transmission() {
+    if (audio_source_needs_sd(config.audio_source) && !init_sd_card()) {
+        printf("Cannot continue without SD card.\n");
+        return false;
+    }
+    
+    if (persist_tables_restored) {
+        // Coefficients came from flash with the configuration
+        active_fir_coefficients = fir_coefficients;
+        active_fir_length = fir_length;
+        persist_tables_restored = false;
+    } else {
+        num_filter_sections = 0;
+        fir_length = 0;
+        if (config.filter_mode == FILTER_MODE_BANDPASS_IIR || 
+            config.filter_mode == FILTER_MODE_BANDPASS_ELLIPTIC) {
+            design_butterworth_bandpass();
+        } else if (config.filter_mode == FILTER_MODE_BANDPASS_FIR) {
+            design_fir_bandpass();
+        }
+    }
+    
+    if (samples_per_word(&config) > 1) {
+        design_sigma_delta(config.sigma_delta_order, config.oversampling_rate);
+    }
+    if (config.signal_mode == SIGNAL_MODE_MULTIPHASE) {
+        // Phases start T/8 = oversampling / 4 PIO cycles apart, and a half
+        // cycle must cover the program's 5 fixed cycles with room for the
+        // arcsine widths
+        if (config.oversampling_rate % 4 != 0 || config.oversampling_rate < 16) {
+            printf("Error: Multi-phase mode needs oversampling of 16, 20, ... 32\n");
+            return false;
+        }
+        design_multiphase_words(config.oversampling_rate);
+    }
+    design_hilbert();  // Cheap; lets a retune switch into SSB
+    if (dpd_table_request[0]) {
+        if (strcmp(dpd_table_request, "default") == 0) {
+            design_dpd_default();
+        } else if ((!audio_source_needs_sd(config.audio_source) && !init_sd_card()) ||
+                   !dpd_load_table(dpd_table_request)) {
+            return false;
+        }
+        dpd_table_request[0] = '\0';  // Kept from here on, and by "persist"
+    }
+    if (config.signal_mode == SIGNAL_MODE_MULTICARRIER) {
+        // Every station below the ladder's Nyquist frequency
+        for (uint32_t k = 0; k < config.station_count; k++) {
+            if (config.stations[k].frequency >= config.carrier_frequency * config.oversampling_rate) {
+                printf("Error: Station %.1f kHz is above %.1f kHz, half the ladder's sample "
+                       "rate; raise --oversample\n", config.stations[k].frequency / 1000.0f,
+                       config.carrier_frequency * config.oversampling_rate / 1000.0f);
+                return false;
+            }
+        }
+        design_multicarrier();
+    }
+    if (config.signal_mode == SIGNAL_MODE_CQAM) {
+        // Phase steps move the edges by whole PIO cycles plus a carried
+        // fraction; the 7 fixed cycles must fit in the shortest one
+        if (config.oversampling_rate < 8) {
+            printf("Error: C-QUAM needs oversampling of at least 8\n");
+            return false;
+        }
+        design_cqam(config.oversampling_rate, config.audio_sample_rate);
+    }
+    if (config.signal_mode == SIGNAL_MODE_FINE_PWM) {
+        // A centred 50% pulse plus the 5 cycles ahead of it fit half a cycle
+        if (config.oversampling_rate < FINE_PWM_MIN_OVERSAMPLING) {
+            printf("Error: Fine PWM needs oversampling of at least %d\n",
+                   FINE_PWM_MIN_OVERSAMPLING);
+            return false;
+        }
+        design_fine_pwm(config.oversampling_rate);
+    }
+    
+    // Restored plans were computed for this configuration when saved
+    const overclock_profile_t* profile = &overclock_profiles[config.overclock_profile];
+    if (!clock_plan_restored) {
+        if (!flash_clock_ok(profile->max_sys_hz)) {
+            printf("Error: Profile %s runs flash above %d MHz; build boot2 with "
+                   "PICO_FLASH_SPI_CLKDIV=4\n", profile->name, OVERCLOCK_FLASH_MAX_HZ / 1000000);
+            return false;
+        }
+        if (!plan_profile_clock(config.carrier_frequency, config.oversampling_rate,
+                                profile, &clock_plan)) {
+            printf("Error: No clock plan reaches %d Hz at %dx oversampling in profile %s\n",
+                   config.carrier_frequency, config.oversampling_rate, profile->name);
+            return false;
+        }
+    }
+    clock_plan_restored = false;
+    apply_clock_plan(&clock_plan);
+    
+    setup_pio_transmitter();
+    
+    dsp_selftest();
+    report_dsp_headroom();
+    return true;
+}
+
 bool safety_check() {
     if (!config.dummy_load_check) return true;
     
@@ -1173,11 +5725,21 @@ void display_startup_info() {
     
     const char* mode_names[] = {
         "Simple High Quality", "Basic Square Wave", "Sigma-Delta",
-        "Pure Sine Wave", "Pre-distortion", "Oversampled"
+        "Pure Sine Wave", "Pre-distortion", "Oversampled", "R-2R DAC",
+        "Multi-phase Square", "C-QUAM Stereo", "DSB Suppressed Carrier",
+        "Upper Sideband", "Lower Sideband", "Multi-carrier", "Fine PWM"
     };
     printf("- Signal Mode: %s\n", mode_names[config.signal_mode]);
     printf("- Modulation Depth: %d%%\n", config.modulation_depth);
-    printf("- WAV File: %s\n", config.wav_filename);
+    printf("- Audio Source: %s\n", audio_source_backends[config.audio_source].name);
+    if (config.playlist && config.audio_source == AUDIO_SOURCE_SD) {
+        printf("- Playlist: %s\n", config.playlist);
+    } else if (audio_source_needs_sd(config.audio_source)) {
+        printf("- WAV File: %s\n", config.wav_filename);
+    } else if (config.audio_source == AUDIO_SOURCE_TEST_SIGNAL) {
+        printf("- Test Signal: %s (seed %u)\n",
+               test_signal_names[config.test_signal], config.test_seed);
+    }
     
     if (config.filter_mode != FILTER_MODE_NONE) {
         const char* filter_names[] = {
@@ -1192,7 +5754,10 @@ void display_startup_info() {
     if (config.verbose_analysis) printf("- Verbose analysis\n");
     if (config.spectrum_analysis) printf("- Spectrum analysis\n");
     if (config.harmonic_analysis) printf("- Harmonic analysis\n");
-    if (config.enable_predistortion) printf("- Digital pre-distortion\n");
+    if (config.enable_predistortion) {
+        printf("- Digital pre-distortion (%s)\n",
+               dpd_table_request[0] ? dpd_table_request : "built-in curve");
+    }
     if (config.oversampling_rate > 1) printf("- %dx oversampling\n", config.oversampling_rate);
     
     // Check if this looks like best quality mode
@@ -1223,44 +5788,50 @@ void display_startup_info() {
 // MAIN FUNCTION
 // ============================================================================
 
+#if !HOST_TESTS  // tests/host_tests.c includes this file and has its own main()
 int main(int argc, char* argv[]) {
     stdio_init_all();
-    sleep_ms(3000);  // Wait for USB serial
-    
-    // Parse command line arguments
-    int parse_result = parse_command_line(argc, argv);
-    if (parse_result != 0) {
-        return (parse_result > 0) ? 0 : 1;  // 1 = help/info, -1 = error
-    }
     
-    // Display startup information
-    display_startup_info();
+    // Unattended boot: a configuration saved with "persist" transmits at
+    // once, with its tables taken from flash instead of being regenerated
+    bool fast_boot = argc <= 1 && persist_restore();
     
-    // Safety checks
-    if (config.educational_mode && !safety_check()) {
-        printf("Exiting for safety.\n");
-        return 1;
+    if (fast_boot) {
+        gpio_init(DUMMY_LOAD_LED_PIN);
+        gpio_set_dir(DUMMY_LOAD_LED_PIN, GPIO_OUT);
+        gpio_put(DUMMY_LOAD_LED_PIN, true);  // Confirmed when the setup was saved
+    } else {
+        sleep_ms(3000);  // Wait for USB serial
+        
+        // Parse command line arguments
+        int parse_result = parse_command_line(argc, argv);
+        if (parse_result != 0) {
+            return (parse_result > 0) ? 0 : 1;  // 1 = help/info, -1 = error
+        }
+        
+        // Display startup information
+        display_startup_info();
+        
+        // Safety checks
+        if (config.educational_mode && !safety_check()) {
+            printf("Exiting for safety.\n");
+            return 1;
+        }
+        safety_confirmed = true;
     }
     
     // Initialize hardware
     printf("Initializing hardware...\n");
     
-    if (!init_sd_card()) {
-        printf("Cannot continue without SD card.\n");
-        return 1;
-    }
-    
     // Initialize signal processing
-    generate_sine_lut();
-    
-    if (config.filter_mode == FILTER_MODE_BANDPASS_IIR || 
-        config.filter_mode == FILTER_MODE_BANDPASS_ELLIPTIC) {
-        design_butterworth_bandpass();
-    } else if (config.filter_mode == FILTER_MODE_BANDPASS_FIR) {
-        design_fir_bandpass();
+    if (!fast_boot) {
+        generate_sine_lut();
+        design_dpd_default();
     }
     
-    setup_pio_transmitter();
+    if (!prepare_transmission()) {
+        return 1;
+    }
     
     // Status LED
     gpio_init(STATUS_LED_PIN);
@@ -1275,7 +5846,17 @@ int main(int argc, char* argv[]) {
     printf("\n");
     
     // Main transmission
-    transmit_wav_file();
+    transmit_audio();
+    
+    // Afterwards the serial shell takes over; "start" or "restart" runs
+    // again with whatever was changed in the meantime
+    while (restart_requested || shell_run_idle()) {
+        restart_requested = false;
+        shell_commit_staged();
+        if (prepare_transmission()) {
+            transmit_audio();
+        }
+    }
     
     // Cleanup
     gpio_put(STATUS_LED_PIN, false);
@@ -1283,4 +5864,5 @@ int main(int argc, char* argv[]) {
     
     printf("Program completed.\n");
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,437 @@
+// IMA-ADPCM reference fixture for tests/host_tests.c
+//
+// Tones plus noise, a clipped full-scale burst and a run of silence,
+// encoded and decoded by ffmpeg (adpcm_ima_wav):
+//   ffmpeg -i mono.wav -c:a adpcm_ima_wav -block_size 256 mono_ima.wav
+//   ffmpeg -i mono_ima.wav -f s16le mono_ref.pcm
+// and the same for stereo with -block_size 512. The arrays are the data
+// chunks of the ADPCM files and ffmpeg's interleaved 16-bit output.
+
+#pragma once
+#include <stdint.h>
+
+#define ADPCM_FIXTURE_MONO_CHANNELS 1
+#define ADPCM_FIXTURE_MONO_BLOCK_ALIGN 256
+
+static const uint8_t adpcm_fixture_mono[768] = {
+    0xb9, 0xce, 0x00, 0x00, 0x7f, 0x77, 0x77, 0x77, 0x67, 0x11, 0xba, 0x83, 0x8c, 0x97, 0xa2, 0x83,
+    0xc8, 0x7a, 0x39, 0x9b, 0xa1, 0x32, 0x6a, 0x8c, 0x89, 0xa1, 0x81, 0x7a, 0x1c, 0x81, 0x9a, 0x86,
+    0x8a, 0xa0, 0x21, 0xb9, 0xc3, 0x49, 0x10, 0x2d, 0x88, 0x09, 0x81, 0x1c, 0x22, 0xa8, 0x78, 0x8b,
+    0x21, 0x98, 0x40, 0x80, 0x4c, 0xd3, 0x95, 0xa0, 0x94, 0x00, 0xb2, 0x92, 0x1c, 0x38, 0x02, 0xa2,
+    0x6f, 0x99, 0x39, 0x5b, 0xb9, 0x42, 0x1e, 0x19, 0xa2, 0x88, 0x88, 0x02, 0x9f, 0x04, 0x1b, 0x00,
+    0x89, 0x29, 0x9a, 0x98, 0x94, 0xa8, 0xa4, 0xbd, 0x05, 0x94, 0x38, 0x0f, 0x91, 0x18, 0x28, 0x2e,
+    0xb2, 0x28, 0x18, 0x2a, 0xf1, 0x12, 0x8a, 0xa5, 0x02, 0xc0, 0x93, 0x5a, 0x90, 0x82, 0xd0, 0xa4,
+    0x18, 0x94, 0xa1, 0xa1, 0x38, 0xe9, 0x94, 0xb3, 0xc0, 0x84, 0x0a, 0x7a, 0x2b, 0x4a, 0x89, 0x8a,
+    0x81, 0x4b, 0x99, 0x00, 0xa0, 0xe8, 0xa6, 0x29, 0x2b, 0x3d, 0x19, 0x01, 0x4b, 0x90, 0x0c, 0xd3,
+    0x93, 0xb4, 0x91, 0x29, 0x49, 0x80, 0x19, 0x19, 0x12, 0x4b, 0x4d, 0xa4, 0x09, 0x5a, 0x80, 0x29,
+    0x59, 0x3b, 0x8b, 0x03, 0x6a, 0x1d, 0x90, 0xc2, 0x30, 0x28, 0x8a, 0x08, 0x3f, 0x09, 0x4d, 0xa0,
+    0xf3, 0x00, 0x80, 0x08, 0x3a, 0xc8, 0x08, 0x29, 0x19, 0x2e, 0x08, 0x80, 0xc9, 0x52, 0x89, 0x3d,
+    0x90, 0x7b, 0x1a, 0x00, 0xd8, 0x82, 0x81, 0xc4, 0x93, 0x80, 0x08, 0x94, 0x18, 0x90, 0x02, 0xe5,
+    0x29, 0x94, 0x88, 0x6a, 0x18, 0x3c, 0x88, 0x1a, 0x19, 0x1b, 0xc1, 0x05, 0x0a, 0x20, 0x09, 0x99,
+    0x11, 0xd5, 0x8b, 0x39, 0xd8, 0x20, 0xc1, 0xb5, 0xb8, 0xa4, 0xc8, 0x06, 0x8a, 0x90, 0x82, 0xb9,
+    0x02, 0x79, 0x0c, 0x20, 0x8a, 0x23, 0x3d, 0xa8, 0x29, 0x30, 0x7c, 0x98, 0x80, 0x4a, 0x80, 0x92,
+    0xff, 0x7f, 0x4b, 0x00, 0x00, 0xff, 0x0a, 0x88, 0x70, 0x03, 0x00, 0x00, 0xbf, 0x08, 0x88, 0x80,
+    0x47, 0x00, 0x00, 0xf0, 0x0b, 0x88, 0x80, 0x37, 0x00, 0x00, 0x00, 0xcf, 0x80, 0x08, 0x78, 0x03,
+    0x00, 0x00, 0xbf, 0x08, 0x88, 0x80, 0x47, 0x00, 0x00, 0xf0, 0x0b, 0x88, 0x80, 0x78, 0x04, 0x00,
+    0x00, 0xbf, 0x80, 0x08, 0x78, 0x03, 0x00, 0x00, 0xf0, 0x0c, 0x88, 0x80, 0x37, 0x00, 0x00, 0xf0,
+    0x8b, 0x80, 0x08, 0x78, 0x04, 0x00, 0x00, 0xbf, 0x80, 0x08, 0x78, 0x03, 0x00, 0x00, 0xf0, 0x0c,
+    0x88, 0x80, 0x37, 0x00, 0x00, 0xf0, 0x8b, 0x80, 0x08, 0x78, 0x04, 0x00, 0x00, 0xbf, 0x80, 0x08,
+    0x78, 0x03, 0x00, 0x00, 0xf0, 0x0c, 0x88, 0x70, 0x19, 0x08, 0x08, 0x19, 0x5a, 0x99, 0xa3, 0x01,
+    0x4b, 0x5a, 0x3d, 0x09, 0x2a, 0x08, 0x39, 0x98, 0xc8, 0xa7, 0x09, 0x0a, 0xc3, 0xb3, 0xa5, 0x09,
+    0x98, 0x91, 0x1f, 0xb2, 0xa4, 0x98, 0x21, 0xf1, 0xa1, 0x19, 0x82, 0x20, 0xa8, 0x1b, 0x32, 0x1b,
+    0x2f, 0xf1, 0x02, 0x01, 0x4c, 0x92, 0x8a, 0xa6, 0x90, 0x95, 0x19, 0x11, 0xa9, 0x93, 0x01, 0x08,
+    0x6e, 0x09, 0x90, 0x02, 0x90, 0x11, 0x9f, 0x02, 0x0a, 0x13, 0x1d, 0xb8, 0x21, 0x0a, 0x1f, 0x99,
+    0x93, 0x6b, 0x0d, 0x93, 0xa0, 0xc0, 0x50, 0x89, 0x00, 0x1c, 0xa0, 0xb3, 0x94, 0xa9, 0x96, 0x88,
+    0x21, 0x19, 0xb8, 0x83, 0x80, 0x43, 0xf1, 0x13, 0x3d, 0x89, 0x04, 0x1a, 0x9d, 0x93, 0x72, 0x00,
+    0xa8, 0x29, 0xd6, 0x82, 0x09, 0x80, 0x29, 0xb1, 0x91, 0xb5, 0x40, 0x3a, 0xa9, 0x2c, 0xd1, 0x98,
+    0xb2, 0x03, 0xc1, 0xd0, 0x68, 0x8a, 0xc1, 0x03, 0xa8, 0x09, 0xba, 0xc7, 0x01, 0x2a, 0xa2, 0xa3,
+    0x3e, 0x7b, 0x0a, 0x91, 0x18, 0x90, 0x4a, 0x88, 0x68, 0x2b, 0x19, 0x0a, 0x43, 0x5d, 0x2a, 0x0b,
+    0x00, 0x00, 0x50, 0x00, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x80, 0x08, 0x08, 0x80, 0x80, 0x08,
+    0x08, 0x80, 0x80, 0x08, 0x08, 0x80, 0x80, 0x08, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80,
+    0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x80, 0x80, 0x80, 0x08, 0x08, 0x08, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0xf8, 0xff,
+    0xff, 0xff, 0xff, 0xc9, 0x83, 0x0b, 0x71, 0x08, 0x4a, 0x2d, 0xc0, 0x93, 0x5a, 0xa8, 0x22, 0xb0,
+    0xd0, 0x22, 0x48, 0xc6, 0x91, 0x82, 0xa1, 0xa9, 0x87, 0x80, 0xc1, 0x10, 0x39, 0x3a, 0xb0, 0x13,
+    0x2c, 0xf4, 0x3a, 0xa1, 0x92, 0x99, 0xb7, 0x82, 0x88, 0xc9, 0x23, 0xa9, 0x90, 0x31, 0x1f, 0x3b,
+    0x4a, 0x8d, 0x00, 0x89, 0x94, 0xd9, 0x12, 0x2c, 0xc4, 0x11, 0x1c, 0x09, 0x81, 0x90, 0x08, 0xb7,
+    0xa3, 0x28, 0x98, 0x32, 0xc8, 0x13, 0x42, 0x0f, 0xa1, 0x01, 0xc2, 0xb5, 0x02, 0x80, 0xc6, 0x11,
+    0x0b, 0x20, 0x0a, 0x29, 0xd2, 0x20, 0x3d, 0xe0, 0xa3, 0x48, 0x2d, 0x09, 0xb0, 0x80, 0x19, 0x29,
+    0x03, 0x3d, 0x1a, 0xfb, 0x82, 0x09, 0x93, 0xd9, 0x93, 0xc1, 0x6a, 0x20, 0x2c, 0x8a, 0x82, 0x98,
+    0x95, 0x91, 0xe3, 0x13, 0x09, 0x98, 0x89, 0x49, 0x91, 0xa5, 0xa1, 0xa5, 0x31, 0xe5, 0x00, 0x80,
+    0x38, 0x5c, 0x98, 0x08, 0x29, 0xf3, 0x01, 0xa1, 0xf3, 0x01, 0x98, 0x10, 0x1c, 0x91, 0x08, 0x4a,
+    0x88, 0x9b, 0x02, 0x7a, 0x1c, 0xa8, 0xe3, 0x11, 0xb0, 0x02, 0x29, 0xa0, 0x99, 0xa7, 0xf3, 0x10,
+    0x2a, 0x90, 0xa2, 0x20, 0xa8, 0xa2, 0x22, 0x4e, 0x18, 0x19, 0xa2, 0x08, 0x7c, 0xa2, 0xc1, 0x93,
+};
+
+static const int16_t adpcm_fixture_mono_pcm[1515] = {
+    -12615, -12628, -12598, -12535, -12399, -12105, -11474, -10117, -7207, -969, 10620, 15358,
+    19665, 13139, 4833, 12384, 11404, 3381, 2303, 17012, 10706, 20261, 11575, 22630,
+    21195, 19890, 9211, 2032, 21610, 13216, 31022, 14835, 8529, 14262, 5576, 13472,
+    23523, 16997, 32423, 13503, 10960, 4023, 1921, 7654, -1032, 3706, 2271, -4255,
+    13544, -9349, -116, 8278, 5735, -5827, -12133, 12711, 9326, -6063, -8861, -6318,
+    -17880, -11574, -2019, -7231, -18286, -8235, -19982, -24720, -11798, -10061, -5323, -21117,
+    -10606, -12517, -14254, -18992, -17557, -13642, -14828, -24536, -20621, -14688, -9295, -10275,
+    -14732, -15542, -4491, -15546, -16981, -13066, -7133, -8211, -11152, -10261, -2967, -1987,
+    -2878, -10172, -1347, 6959, -4907, 12466, 5529, 7631, -1924, 13712, 7406, 9317,
+    11054, 18950, 8899, 15425, 11866, 2158, 6073, 4887, 12438, 17341, 18232, 22284,
+    18601, 8555, 27221, 19590, 12653, 6347, 19724, 7563, 24936, 17999, 3284, 12839,
+    28475, 1146, 12318, 2161, 11394, 25384, 12666, 10354, 8252, 6341, 4604, 12500,
+    13935, -5643, -14037, 8856, 11933, -7653, -22, 2290, 4392, -1341, -3078, -7816,
+    -637, -7163, -10722, -11800, -14741, -6718, -9954, -10934, -15391, -8097, -13000, -22806,
+    -31942, -18890, -17153, -2939, -8672, -10409, 646, -20892, -17815, -9421, -17052, -19364,
+    -13058, -14969, -6283, -26814, -12824, -106, -16293, -18395, -8840, -10577, -5839, -13018,
+    -6492, -2933, -19114, -7552, -1246, -10801, -12538, 4835, -6727, 3784, 5695, 7432,
+    -6782, 6595, 1383, -6513, 9281, 11383, 5650, 14336, 12757, 14192, -165, 17035,
+    5473, 3371, 9104, 24740, 18434, 24167, 15481, 20219, 13040, 11735, 20041, 16805,
+    4057, 19693, 13387, 26764, 14603, 16182, 3260, 18896, 16794, 7239, 8976, 1080,
+    22618, 1073, 15063, 2345, 23157, 14763, 12220, 658, -1444, 4289, 2552, -8503,
+    4419, -793, -5531, -4096, -2791, -1605, -6998, -7978, -19567, 964, -13026, -20657,
+    -9095, -23810, -14255, -32768, -14962, -21899, -15593, -9860, -8123, -19178, -6256, -4519,
+    -9257, -22179, -20442, -9387, -25181, -10466, -16199, -563, -15278, -9545, -14757, -19495,
+    -12316, -16231, -5552, -4117, -5422, -8981, -5745, -8686, -6012, -1960, 250, -4438,
+    1041, -7063, 2645, 14392, 6496, 2189, 3494, -2439, 9427, 11006, 9571, 5656,
+    11589, 8353, 19139, 9088, 18224, 9918, 8840, 15704, 16595, 12543, 22120, 7763,
+    13496, 15233, 10495, 17674, 5927, 7506, 17557, 16252, 22185, 16792, 15812, 14921,
+    15731, 4680, 15735, 11428, 12733, -319, 15317, 17419, 7864, 20025, -3665, -280,
+    2797, 5595, 3052, 740, 2842, -6713, 5448, 3869, -9053, -10790, -9211, -13518,
+    -6992, -10551, -7315, -20063, -11377, -12956, -11521, -10216, -11402, -14638, -23463, -17530,
+    -5664, -10402, -11837, -26194, -12817, -11080, -15818, -25869, -6291, -20281, -12650, -10338,
+    -8236, -10147, -29258, -16540, -18852, -12546, -14457, 1179, -17741, 65, -6872, -4770,
+    -6681, -8418, -6839, 6083, 871, -708, 3599, 4904, 1345, 6738, 7718, 17524,
+    556, -6381, 4130, 21330, 14393, 12291, 10380, 1694, 22225, 19427, 27058, 6246,
+    25832, 23289, 20977, 10466, 16199, 10987, 15725, 5674, 9589, 13148, 3440, 17797,
+    19708, 11022, 12601, 14036, 20562, 17003, 18081, 15140, 12466, 14897, 17107, 24474,
+    13688, 3637, 2332, -1227, 6324, 5344, -4462, -3157, 2776, 6012, -2813, 10239,
+    -1922, -3501, -13552, -1805, -9701, -11136, -22883, -2352, 446, -12272, -14584, -12482,
+    -18215, -9529, -11108, -15415, -24551, -18618, -17540, -20481, -7109, -24309, -21997, -19895,
+    -10340, -19026, -20605, -10554, -4028, -17080, -4919, -6498, -13677, -17592, -11659, -10581,
+    -3717, -11740, 4441, 2129, -4177, -2266, -4003, -11899, 1023, 2760, 1181, 8360,
+    4445, 32767, 32767, 32767, 18058, -13475, -32768, -29044, -32429, -32768, -29970, 8186,
+    32767, 32767, 32767, 32767, 32767, 32767, -1920, -30591, -32768, -29383, -32460, -32768,
+    -30225, -32537, -1004, 32767, 32767, 32767, 32767, 32767, 32767, -5389, -32768, -29044,
+    -32429, -32768, -29970, -32513, 2174, 30845, 32767, 32767, 32767, 32767, 32767, 32767,
+    1234, -32768, -28673, -32397, -32768, -29691, -32489, 5667, 32767, 32767, 32767, 32767,
+    32767, 32767, -1920, -30591, -32768, -29383, -32460, -32768, -30225, -32537, -1004, 32767,
+    32767, 32767, 32767, 32767, 32767, -5389, -32768, -29044, -32429, -32768, -29970, -32513,
+    -32768, -1235, 32767, 32767, 32767, 32767, 32767, 32767, -5389, -32768, -29044, -32429,
+    -32768, -29970, -32513, 2174, 30845, 32767, 32767, 32767, 32767, 32767, 32767, 1234,
+    -32768, -28673, -32397, -32768, -29691, -32489, 5667, 32767, 32767, 32767, 32767, 32767,
+    32767, -1920, -30591, -32768, -29383, -32460, -32768, -30225, -32537, -1004, 32767, 32767,
+    32767, 32767, 32767, 32767, -5389, -32768, -29044, -32429, -32768, -29970, -32513, 2174,
+    30845, 32767, 32767, 32767, 32767, 32767, 32767, 1234, -32768, -28673, -32397, -32768,
+    -29691, -32489, 5667, 32767, 32767, 32767, 32767, 32767, 32767, -1920, -30591, -32768,
+    -29383, -32460, -32768, -30225, -32537, -1004, 32767, 32767, 32767, 32767, 32767, 32767,
+    -5389, -32768, -29044, -32429, -32768, -29970, -32513, 2174, 30845, 32767, 32767, 32767,
+    32767, 32767, 32767, 1234, -32768, -28673, -32397, -32768, -29691, 12280, -7, 11165,
+    7780, 10857, 8059, 10602, 3665, 9971, 416, 19527, 11896, 4959, 19674, 10119,
+    15331, 16910, 6859, 18606, 10710, 26504, 3380, 24925, 16531, 19074, 7512, 18023,
+    16112, 17849, 13111, 23162, 21857, 18298, 17220, 8395, 26194, 13476, 6539, 8641,
+    -914, 823, 11878, -1044, 11117, 62, 15856, 5345, -388, 1349, -230, -4537,
+    -622, -4181, -20362, -13425, -2914, -16291, -655, -11166, -13077, -18289, -13551, -6372,
+    -2457, -20256, -12625, -24187, -30493, -24760, -16074, -17653, -16218, -9692, -10878, -16271,
+    -23135, -20461, -16409, -11252, -15940, -14114, -22416, -16483, -13247, -27956, -17445, -15534,
+    -10322, -8743, -21665, -6029, 4482, -1251, -9937, -11516, 7150, -5568, -3256, -9562,
+    11460, 3066, -4565, 2372, 8678, 14411, 9199, 1303, 11354, 7439, 10998, 12076,
+    11096, 11987, 1451, 20117, 12486, 14798, 16900, 11167, 19853, 21432, 22867, 18952,
+    22511, 25747, 11038, 4732, 14287, 16024, 8128, 9563, 18699, 22258, 10392, 15130,
+    13695, 4559, 8118, 13511, 8608, 9499, -2658, 2554, -2184, -6491, 2645, -914,
+    -8465, 4283, -14828, -12285, 3902, -2404, -493, -9179, -7600, -20522, -18785, -1412,
+    -8349, -10451, -8540, -6803, -21017, -15284, -13547, -21443, -11392, -20528, -9849, -14156,
+    -18071, -24004, -9981, -15714, -17451, -19030, -14723, -8197, -11756, -8520, -9500, -15740,
+    -10067, -10803, -10134, -10742, -6868, -2339, -513, -8815, -509, 2727, -8059, 1992,
+    -1923, -3109, 6599, 7904, 1971, 5207, -5579, -9886, -750, -4309, 1084, 15793,
+    17895, 19806, 18069, 10173, 5866, 12392, 27818, 4694, 20083, 17285, 9654, 11966,
+    14068, 12157, 6945, 14841, 19148, 10012, 13571, 10335, 21121, 11070, 12375, 23054,
+    15875, 25011, 21452, 16059, 7234, 13167, 16403, 5617, 4182, 267, 6200, -1351,
+    5513, 6404, 8835, 2205, 3096, -5819, -7005, 7018, -2537, -4274, 464, -12458,
+    -297, 1282, -153, -6679, -10238, -9160, -14063, -20303, -8146, -23782, -17476, -15565,
+    -24251, -16355, -9176, -15702, -7396, -12789, -25537, -13376, -24431, -2893, -18282, -15484,
+    -7853, -14790, -16892, -11159, -9422, -14160, -21339, -9592, -11171, -12606, -13911, 1515,
+    -13200, -3645, -8857, -4119, -11298, -9993, -1687, 8021, -6336, 14686, 696, 13414,
+    -2773, -671, 0, 1911, 174, -1405, 30, -1275, -89, 989, 9, -882,
+    -72, 664, -5, 603, 50, -453, 4, -411, -33, 310, -2, 282,
+    24, -210, 3, -191, -15, 145, 0, 132, 12, -97, 2, -88,
+    -6, 68, 0, 61, 5, -46, 0, 42, 4, -30, 1, -27,
+    -1, 22, 1, -18, -1, 15, 1, -12, 0, 11, 1, -8,
+    0, 7, 1, -5, 0, 5, 1, -3, 0, 3, 0, 2,
+    0, 2, 0, 2, 1, 0, 1, 0, 1, 0, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -12, -42, -105, -241,
+    -535, -1166, -2523, -5433, -11671, -14345, -21639, -14775, -15666, -21339, -20603, -18594,
+    -9461, -10766, -9580, -14973, -6148, -19200, -10514, -8935, -21857, -9696, -14434, -21613,
+    -7256, -9167, -17853, -9957, -2778, -1473, -9779, -8701, -19487, -12308, -5782, -6968,
+    2740, 19708, -1104, 7290, -341, 11221, 9119, 14852, 6166, 1428, -5751, 13827,
+    11029, 13572, 11260, 17566, 366, 2678, 8984, 3251, 15412, 7516, 17567, 18872,
+    10566, 18117, 21058, 13035, 18428, 27253, 9454, -3264, 12923, 19229, 9674, 18360,
+    13622, 9315, 5400, 23199, 5393, 16955, 14853, 12942, 11205, 6467, -6455, 5706,
+    13602, 9295, 2769, 3955, 719, 3660, 9900, -2257, 2955, -8100, 1951, -4575,
+    6104, -9690, -11792, -9881, -8144, -12882, -14317, -2570, -7308, -11615, -25972, -16417,
+    -11205, -25419, -15864, -228, -19148, -11517, -4580, -23500, -15869, -22806, -20704, -14971,
+    -16708, -15129, -19436, -20741, -19555, -3374, -19561, -4846, -14401, -16138, -8242, -9677,
+    -13592, -7659, -108, -1088, -9111, -1560, 1381, 5838, 13132, -1577, 525, 6258,
+    -2428, 2310, 3745, 10271, -408, 15386, 671, 10226, 11963, 13542, 12107, 29075,
+    8263, 16657, 24288, 8101, 10203, 12114, 20800, 12904, 14339, 10424, 16357, 21750,
+    10964, 12399, 18925, 5873, 18034, 19613, 947, 18753, 7191, 5089, 22289, -3148,
+    13780, 4547, 7345, 9888, -6299, -4197, -6108, -11320, -6582, -10889, -4363, 3943,
+    5021, -5765, 4286, -2240, 1319, -6232, -20941, -10430, -12341, -17553, -15974, -5923,
+    -9838, -13397, -25263, -14208, -18515, -14600, -25279, -32458, -15490, -13178, -2667, -19867,
+    -8305, -18816, -20727, -12041, -13620, -15055, -18970, -5918, -11130, -6392, -10699, -1563,
+    -16989, -2274, 3459, -1753, -174, -1609, -5524, -9083, -10161, -13102, -5079, -1843,
+    -4784, 5022, -1504, 2055, -3338, 7448, 269, 4184, 12490, 24356, 3825, 6623,
+    9166, 11478, 9376, 7465, 19626, 5412, 26434, 23636, 16005, 13693, 15795, 10062,
+    18748, 29803, 8265, 17498, 20296, 27927, 16365, 31080, 2414, 14701, 18425, 15040,
+    5807, 8605, 16236, -4576, 3818, 11449, 4512, 2410, 4321, -4365, 9849, 7938,
+    6201, -4854, -9161, -2635, -1449, -6842, 7867, -11053, -3422, -5734, -16245, -2868,
+    -25453, -16220, -7826, -5283, -21470, -10959, -9048, -14260, -6364, -4929, -11455, -15014,
+    -18250, -3541, -14052, -675, -26735, -23011, -12854, -28243, -14253, -11710, -18647, -8136,
+    -17691, -15954, -8058, -9493, -16019, -10086, -15479, -10576, -6119, -16655, -3733, -5470,
+    -732, -5039, -1124, 4809, -584, -1564, -673, -7967, 6742, 17253, 7698, 12910,
+    -1304, 12073, 6861,
+};
+
+#define ADPCM_FIXTURE_STEREO_CHANNELS 2
+#define ADPCM_FIXTURE_STEREO_BLOCK_ALIGN 512
+
+static const uint8_t adpcm_fixture_stereo[1024] = {
+    0xdb, 0x06, 0x00, 0x00, 0x57, 0x03, 0x00, 0x00, 0xf7, 0x7f, 0x7f, 0x8a, 0x7d, 0x77, 0x77, 0x7f,
+    0xc7, 0x17, 0x97, 0x31, 0x77, 0x59, 0xc0, 0x20, 0x21, 0xe7, 0x00, 0x2b, 0x3b, 0x9b, 0xc0, 0x85,
+    0x38, 0xf3, 0xa0, 0x41, 0xc1, 0x39, 0xf3, 0x80, 0x0a, 0xb2, 0xa8, 0xa1, 0x4b, 0x3b, 0xa0, 0xa8,
+    0xc2, 0x21, 0xb4, 0xad, 0x20, 0x0a, 0xc2, 0x69, 0x7c, 0x08, 0x19, 0xb9, 0x9c, 0x11, 0xc4, 0x92,
+    0x12, 0xb0, 0xa8, 0x40, 0x19, 0x82, 0x30, 0xa0, 0xd9, 0xa5, 0x09, 0xc4, 0x7b, 0xa0, 0x84, 0x08,
+    0x18, 0x00, 0xa1, 0x19, 0x38, 0x5c, 0x2d, 0x2a, 0x23, 0xca, 0x79, 0x3c, 0x00, 0x01, 0xc0, 0x19,
+    0x5a, 0x0a, 0x90, 0x82, 0x3a, 0x4f, 0xc8, 0x91, 0x81, 0xf4, 0xa3, 0x81, 0x11, 0x2a, 0x4a, 0x1c,
+    0x01, 0x81, 0x4c, 0xa9, 0x98, 0x4b, 0x1b, 0xc2, 0x02, 0x49, 0x98, 0xa0, 0x19, 0x98, 0x95, 0x88,
+    0x79, 0xc0, 0x81, 0xa3, 0x80, 0xa5, 0x39, 0xb2, 0x18, 0x83, 0xb9, 0x99, 0x82, 0x87, 0xc0, 0x84,
+    0x63, 0x2e, 0x0c, 0xa1, 0x09, 0xb3, 0x00, 0xa7, 0x10, 0x3c, 0xf3, 0x00, 0x80, 0x81, 0xa0, 0x30,
+    0x18, 0x09, 0x1c, 0xb1, 0xf1, 0x81, 0xc3, 0x13, 0x02, 0x8a, 0xb2, 0x5e, 0x0d, 0x89, 0x19, 0x89,
+    0x2a, 0x1a, 0x02, 0xbb, 0xa0, 0x10, 0x3f, 0x2e, 0xb5, 0xe3, 0x04, 0x2a, 0x98, 0x01, 0x1c, 0x3a,
+    0x00, 0x8a, 0x90, 0x82, 0x8b, 0x59, 0x90, 0x38, 0x20, 0x09, 0x06, 0x9b, 0xa8, 0x62, 0x19, 0x80,
+    0xa7, 0xa3, 0x48, 0x2a, 0x40, 0xa4, 0x10, 0x89, 0x09, 0x10, 0x39, 0xf2, 0xa0, 0x79, 0x5d, 0x28,
+    0x22, 0x0b, 0xc1, 0x04, 0xb8, 0x28, 0x91, 0x3a, 0x8a, 0x12, 0xa8, 0x38, 0x1c, 0xea, 0x11, 0x89,
+    0xca, 0xf5, 0x30, 0x2b, 0x4a, 0x8a, 0x1a, 0x19, 0x9a, 0xf8, 0x12, 0x18, 0xbb, 0xb4, 0x81, 0x0b,
+    0xb9, 0x88, 0x88, 0xb6, 0xb5, 0x3d, 0x4b, 0x93, 0x49, 0x09, 0x19, 0xc2, 0x87, 0x49, 0xb8, 0xb3,
+    0x1c, 0x0b, 0x78, 0x2d, 0xb7, 0x20, 0x19, 0x7c, 0x91, 0x19, 0x00, 0xa0, 0x3a, 0x89, 0x18, 0xb8,
+    0x48, 0x2a, 0x8b, 0x52, 0x31, 0x91, 0xa9, 0x06, 0x8e, 0x12, 0xa3, 0x98, 0x9c, 0x94, 0x92, 0x0c,
+    0xa1, 0x90, 0x37, 0x8d, 0x90, 0x98, 0x21, 0x8c, 0x80, 0x92, 0x85, 0xb0, 0x90, 0xf4, 0x91, 0x91,
+    0x04, 0x08, 0x90, 0x49, 0x18, 0x2e, 0x81, 0x49, 0x0c, 0x33, 0x8f, 0xd4, 0x0b, 0x08, 0xa6, 0x98,
+    0x02, 0x88, 0xb2, 0xf9, 0x22, 0x99, 0x96, 0xf8, 0x88, 0x17, 0x00, 0x00, 0x08, 0x17, 0x00, 0x00,
+    0xf0, 0x8b, 0x80, 0x08, 0xf0, 0x8b, 0x80, 0x08, 0x37, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00,
+    0xcf, 0x80, 0x08, 0x78, 0xcf, 0x80, 0x08, 0x78, 0x03, 0x00, 0x00, 0xbf, 0x03, 0x00, 0x00, 0xbf,
+    0x08, 0x88, 0x80, 0x47, 0x08, 0x88, 0x80, 0x47, 0x00, 0x00, 0xf0, 0x0b, 0x00, 0x00, 0xf0, 0x0b,
+    0x88, 0x80, 0x37, 0x00, 0x88, 0x80, 0x37, 0x00, 0x00, 0x00, 0xcf, 0x80, 0x00, 0x00, 0xcf, 0x80,
+    0x08, 0x78, 0x03, 0x00, 0x08, 0x78, 0x03, 0x00, 0x00, 0xbf, 0x08, 0x88, 0x00, 0xbf, 0x08, 0x88,
+    0x80, 0x47, 0x00, 0x00, 0x80, 0x47, 0x00, 0x00, 0xf0, 0x0b, 0x88, 0x80, 0xf0, 0x0b, 0x88, 0x80,
+    0x37, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0xcf, 0x80, 0x08, 0x78, 0xcf, 0x80, 0x08, 0x78,
+    0x03, 0x00, 0x00, 0xf0, 0x03, 0x00, 0x00, 0xf0, 0x0c, 0x88, 0x80, 0x37, 0x0c, 0x88, 0x80, 0x37,
+    0x00, 0x00, 0xf0, 0x8b, 0x00, 0x00, 0xf0, 0x8b, 0x80, 0x08, 0x78, 0x04, 0x80, 0x08, 0x78, 0x04,
+    0x00, 0x00, 0xbf, 0x80, 0x00, 0x00, 0xbf, 0x80, 0x08, 0x78, 0x03, 0x00, 0x08, 0x78, 0x03, 0x00,
+    0xff, 0x7f, 0x54, 0x00, 0xff, 0x7f, 0x54, 0x00, 0x00, 0xbf, 0x08, 0x88, 0x00, 0xbf, 0x08, 0x88,
+    0x70, 0x03, 0x00, 0x00, 0x70, 0x03, 0x00, 0x00, 0xbf, 0x08, 0x88, 0x80, 0xbf, 0x08, 0x88, 0x80,
+    0x47, 0x00, 0x00, 0x8a, 0x47, 0x00, 0x00, 0x0d, 0xc1, 0xa4, 0x20, 0x0b, 0x18, 0x9a, 0x85, 0x90,
+    0xa0, 0x29, 0xda, 0x94, 0xa2, 0x11, 0xc1, 0x11, 0x01, 0xaa, 0x2d, 0x01, 0x18, 0x3c, 0x1e, 0xb0,
+    0xb1, 0x6d, 0x98, 0x09, 0x80, 0x90, 0x10, 0x08, 0xb3, 0xb1, 0x80, 0x82, 0xf9, 0xb2, 0x03, 0x1b,
+    0x88, 0x95, 0xf3, 0x94, 0xe8, 0x12, 0xb8, 0x3c, 0x08, 0x09, 0x62, 0xab, 0x92, 0xa1, 0xb7, 0xa4,
+    0x01, 0x48, 0x08, 0x5a, 0xb4, 0x92, 0x93, 0xa3, 0xb9, 0x42, 0x29, 0x91, 0x0b, 0x86, 0x18, 0xa3,
+    0xa0, 0x8b, 0x7b, 0xa1, 0x96, 0xb9, 0x12, 0x20, 0x59, 0x29, 0x09, 0x90, 0x3c, 0x28, 0x8e, 0xb1,
+    0x92, 0x6a, 0xb8, 0xa3, 0xb3, 0x90, 0xb7, 0xd4, 0x3a, 0xe1, 0xa3, 0x28, 0x08, 0x08, 0x39, 0x9a,
+    0x0a, 0x30, 0xae, 0x1c, 0xaa, 0xa7, 0x29, 0x2b, 0x11, 0xf1, 0x81, 0x09, 0x80, 0x12, 0x9d, 0x61,
+    0xc0, 0xa2, 0x2b, 0x5d, 0x1d, 0x90, 0x95, 0x18, 0xb1, 0x04, 0x0d, 0x59, 0x28, 0xa9, 0x10, 0xa2,
+    0x08, 0x08, 0x80, 0x08, 0x80, 0x80, 0x08, 0x80, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x08, 0x80,
+    0x80, 0x08, 0x08, 0x80, 0x80, 0x08, 0x08, 0x80, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x80, 0x08,
+    0x80, 0x08, 0x08, 0x80, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x80, 0x08, 0x80, 0x08, 0x08, 0x80,
+    0x80, 0x08, 0x80, 0x08, 0x08, 0x80, 0x08, 0x80, 0x80, 0x08, 0x80, 0x08, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x08, 0x08, 0x08, 0x08, 0x80, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00,
+    0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x70, 0x77, 0x00, 0x00, 0x70, 0x77, 0x77, 0x77, 0x75, 0x7c, 0x73, 0x77, 0x77, 0xf2,
+    0x39, 0x19, 0xe9, 0x10, 0x1d, 0x29, 0x20, 0x0f, 0xa1, 0x09, 0xc0, 0x3b, 0xa9, 0x38, 0xea, 0x96,
+    0xa3, 0x18, 0x8a, 0xea, 0x80, 0x1a, 0x01, 0x3d, 0xb4, 0xa2, 0x21, 0x6f, 0x98, 0xc6, 0xa3, 0x28,
+    0x9a, 0x90, 0x81, 0x22, 0x28, 0x10, 0x1a, 0x40, 0x9e, 0x10, 0x48, 0x8d, 0xaa, 0xb5, 0x20, 0x38,
+    0xa3, 0xb3, 0x30, 0x1c, 0xc1, 0x03, 0x31, 0xdf, 0x5b, 0x21, 0x9b, 0x38, 0x94, 0x80, 0x3c, 0x88,
+    0x7c, 0x09, 0x29, 0x39, 0x19, 0x8d, 0x22, 0x3c, 0xa0, 0xa3, 0x4b, 0xb3, 0x3c, 0x1d, 0x29, 0x0b,
+    0xb7, 0x21, 0xe1, 0xa4, 0x80, 0x10, 0x90, 0xb0, 0xa1, 0x39, 0x3a, 0x90, 0x03, 0x82, 0xb2, 0xf0,
+    0x90, 0x99, 0x82, 0x1a, 0x78, 0x18, 0x4a, 0x91, 0x4a, 0xf8, 0x7a, 0x1b, 0x92, 0xb1, 0x11, 0xd4,
+    0xb1, 0xa3, 0x90, 0x08, 0x97, 0x29, 0x0a, 0x82, 0x1d, 0xc8, 0xb5, 0x29, 0x1a, 0x99, 0xd7, 0x82,
+    0x93, 0xe6, 0x81, 0x88, 0x08, 0x4a, 0x0d, 0xa2, 0x18, 0x90, 0x99, 0x11, 0x91, 0x09, 0x3a, 0xb1,
+    0x6a, 0xb8, 0x40, 0x19, 0x89, 0x4b, 0x1b, 0x88, 0x2d, 0xc8, 0x85, 0x00, 0x21, 0xaa, 0x49, 0x08,
+    0xa9, 0x93, 0x82, 0x96, 0x71, 0x7d, 0x98, 0x18, 0x18, 0xc3, 0x18, 0x01, 0x01, 0x4a, 0x19, 0x1a,
+};
+
+static const int16_t adpcm_fixture_stereo_pcm[2020] = {
+    1755, 855, 1768, 846, 1738, 866, 1675, 909, 1811, 1002, 1517, 1202,
+    2148, 1633, 1696, 707, 1614, 2694, 2735, 6954, 1293, 16087, 4203, 12172,
+    5450, 25224, 11120, 26961, 8689, 12747, 10899, 14658, 15587, 23344, 17413, 12289,
+    20180, 22340, 27728, 13204, 13705, 9645, 15616, 10723, 17353, 1898, 6298, 14950,
+    13477, 13213, 12172, 17951, 20478, 5029, 28029, -183, 13320, 10872, 15422, 20923,
+    5867, 1345, 11079, 4143, 25293, 1600, 15738, -14587, 17475, 4333, 25371, -13473,
+    15320, 2714, 14015, 4816, 8082, -4739, 11318, -6476, 6415, -14372, 10872, -12937,
+    3578, -6411, 6519, -12344, 10976, -11266, 18270, -6363, 11406, -14386, 1600, -17622,
+    -4926, -4874, -15605, -20510, 5933, -26816, 2856, -21083, 5654, -15871, -1977, -1657,
+    4960, -18857, -1346, -7295, -14723, -13601, -6037, -19334, -1299, -14122, 136, -6226,
+    -9000, -7661, -10186, -6356, -15579, 1950, -14599, 3028, -6576, -1875, -9812, -8115,
+    -20598, 4042, -4804, 5779, -15315, -2117, -21048, 10805, -19311, 9068, -5097, 7489,
+    -22297, 8924, -24609, 7619, -18303, 15925, -16392, 6217, -14655, 20574, -9917, -448,
+    -17096, 13542, -21011, 824, -17452, 12386, -9901, 14488, -4998, 16399, -9455, 21611,
+    -16749, 23190, -19690, 24625, -6318, 12878, -23518, 8140, -7331, 12447, -17842, 5921,
+    3180, 14227, -10810, -1954, -8267, 18858, -5955, 16060, -12261, -6833, -2706, 2400,
+    -4443, -5994, 295, 1637, -1140, 8574, 10607, -1937, -13083, 7618, 10617, -1068,
+    -4772, 13146, 3622, -4054, 1079, 2883, 8016, 781, 10118, -4952, 15851, -17113,
+    14114, -2899, -100, -16276, 17100, -11064, 10163, -3168, -348, -16090, 9207, -21302,
+    10944, -16564, 6206, -17999, 19128, -21914, 17391, -8862, 12653, -14074, 14088, -15653,
+    7562, -17088, 4003, -15783, 20184, -16969, 22496, -5103, 3576, -12999, 11207, -17306,
+    8895, -8170, 23610, -2237, 14055, -9788, 12318, -4885, 17056, -5776, 27107, 6381,
+    25802, 4644, 22243, 6223, 14692, -6699, 11751, 8937, 9077, 6835, 14750, 1102,
+    24327, 2839, 7359, 13894, 18921, 3843, 1, 5148, 2544, 6334, 9481, 22515,
+    -1030, 10953, 881, 13055, 6093, 11144, -8121, 16356, 5256, 14777, 17417, 16212,
+    -6273, 9686, -2888, 10872, 189, 18423, -2609, 21364, 5022, 7992, -1915, 13725,
+    187, 11988, -17013, 23043, -10076, 10121, -3770, 22282, -17147, 27020, -8461, 11226,
+    -6882, 13328, -14061, 7595, -15366, 5858, -9433, 1120, -16984, 5427, -29732, 1512,
+    -10621, 326, -23339, 1404, -11777, -3499, -22288, -2608, -16555, -177, -7869, -11228,
+    -6290, -173, -16341, -18839, -25477, -6121, -12425, -8433, -24586, -14739, -13531, -9006,
+    -32197, -7269, -9304, -21483, -6227, -15750, -20217, -24436, -7499, -13381, -5187, -23432,
+    -3085, -24737, -12640, -28296, -14377, -16430, -12798, -14851, -17105, -19158, -10579, -20463,
+    -11765, -12157, -10687, -13235, -5784, -18138, -8458, -13681, -7648, -3145, 1929, -7452,
+    3234, -3537, -5072, -2351, -8308, -3429, 6401, -2449, -4110, 5574, 9267, 15282,
+    581, 8756, -998, 9942, 11924, 13178, 3238, 10237, 11134, 9346, 6827, 10156,
+    8132, 6473, 9318, 4464, 12554, 13597, 9613, -760, 15853, 20262, 19905, 17464,
+    8854, 30182, 16750, 27870, 23929, 13155, 14793, 11244, 15979, 19930, 19215, 24668,
+    10390, 20361, 21069, 13835, 22504, 22141, 15978, 12433, 14792, 16348, 20185, 10415,
+    23126, -3608, 22235, 2125, 18183, 7337, 17447, 2599, 22135, 1164, 19091, -5362,
+    14110, 5317, 21477, -1862, 6768, -3167, 8870, -9100, 22247, -5864, 10086, -8805,
+    17982, -6131, 10803, -11804, 6888, -16961, 5702, -10934, -10479, -16607, 1083, -14397,
+    7389, -15066, 5478, -19328, 10690, -18775, 5952, -13240, -4099, -18397, -5404, -25764,
+    -6590, -18900, -7668, -25140, -8648, -17846, 2941, -10982, -8114, -13656, -12421, -1499,
+    -674, -3236, -5412, -7974, -3977, 4948, -7892, 3211, -4333, -7844, 1060, 2207,
+    -7765, -6929, -18444, 10870, -14137, -6936, -23273, -4624, -22087, 5887, -23165, 154,
+    -8456, 5366, -31580, -8848, -16191, 19818, -7797, -661, -15428, 25408, -22365, 15251,
+    -16059, 12174, -14148, 9376, -12411, 17007, -10832, 14695, -18011, -20, -19316, 5713,
+    -8637, 17874, -15816, 22612, -9290, 18305, -17596, 14390, -18674, 8457, -13771, 22480,
+    -3965, 24391, -20933, 8755, -23245, 2449, -12734, 19649, -7001, 12712, 5160, 23223,
+    -2736, 17490, -4171, 1854, -8086, 3956, -4527, 5867, -9920, 655, -8940, -924,
+    -11614, -5231, 543, -1316, 12704, 4617, -4669, -5091, -6981, -6396, -4879, -5210,
+    -6790, -8446, 1896, 379, -2842, -17420, 12952, -9789, 10850, -16726, 12761, -10420,
+    600, -16153, 14814, -17890, 16725, -13152, 14988, -31818, 16567, -19100, 18002, -12163,
+    14087, -14265, 10528, -19998, 20236, -4362, 8489, -19077, 10068, -17166, 20119, -18903,
+    29255, -17324, 11456, 1342, 8913, -11376, 29725, -13688, -1054, -19994, 19425, -10439,
+    23149, -1753, 19764, -6491, 16687, -10798, 30677, 6170, 12871, -767, 5934, -2869,
+    -25599, -31535, -29694, -32768, -32768, -29044, 18018, 21742, 30305, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, -1920, -1920, -30591, -30591,
+    -32768, -32768, -29383, -29383, -32460, -32460, -32768, -32768, -30225, -30225, 4462, 4462,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 1234, 1234, -32768, -32768, -28673, -28673, -32397, -32397, -32768, -32768,
+    -29691, -29691, -32489, -32489, 5667, 5667, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, -1920, -1920, -30591, -30591, -32768, -32768,
+    -29383, -29383, -32460, -32460, -32768, -32768, -30225, -30225, -32537, -32537, -1004, -1004,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    -5389, -5389, -32768, -32768, -29044, -29044, -32429, -32429, -32768, -32768, -29970, -29970,
+    -32513, -32513, 2174, 2174, 30845, 30845, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 1234, 1234, -32768, -32768, -28673, -28673,
+    -32397, -32397, -32768, -32768, -29691, -29691, -32489, -32489, 5667, 5667, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, -1920, -1920,
+    -30591, -30591, -32768, -32768, -29383, -29383, -32460, -32460, -32768, -32768, -30225, -30225,
+    -32537, -32537, -1004, -1004, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, -5389, -5389, -32768, -32768, -29044, -29044, -32429, -32429,
+    -32768, -32768, -29970, -29970, -32513, -32513, 2174, 2174, 30845, 30845, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 1234, 1234,
+    -32768, -32768, -28673, -28673, -32397, -32397, -32768, -32768, -29691, -29691, -32489, -32489,
+    5667, 5667, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 1234, 1234, -32768, -32768, -28673, -28673, -32397, -32397,
+    -32768, -32768, -29691, -29691, -32489, -32489, 5667, 5667, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, -1920, -1920, -30591, -30591,
+    -32768, -32768, -29383, -29383, -32460, -32460, -32768, -32768, -30225, -30225, -32537, -32537,
+    -1004, -1004, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, -5389, -5389, -32768, -32768, -29044, -29044, -32429, -32429, -32768, -32768,
+    -29970, -29970, -32513, -32513, 2174, 2174, 30845, 30845, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, -1920, -1920, -30591, -30591,
+    -32768, -32768, -29383, -29383, -32460, -32460, -32768, -32768, -30225, -30225, 4462, 4462,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    -1920, -1920, -30591, -30591, -32768, -32768, -29383, -29383, -32460, -32460, -32768, -32768,
+    -30225, -30225, -32537, -32537, -1004, -1004, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 18777, 1988, 16234, 6083, 23171, 2359, 4251, 12516,
+    27144, -2873, 11755, -11267, 14553, 16714, 27271, 12990, 11084, 16375, 13186, 7142,
+    15097, 21132, 6411, 8414, 1673, 15351, 8852, 21657, 2326, 27390, -10726, 11754,
+    4910, 18060, -1396, 23793, 4337, 22056, 6074, 26794, -1822, 13872, -9001, 26033,
+    -23358, 5502, -13803, 13896, -8591, 16439, -7012, 252, -2705, 2354, -11841, 443,
+    -24893, 2180, -2308, -2558, -5385, -1123, -13779, 2792, -21410, 1606, -19098, 2684,
+    -4383, -257, -17760, -13629, -12548, -4074, -23603, -16235, -22168, -5180, -23473, -3745,
+    -17540, -12881, -18618, -9322, -19598, -10400, -20489, -23148, -11574, -14462, -15133, -9724,
+    -7582, -11159, -22291, -20295, -3371, -30974, -11002, -20923, -13314, -14397, -11212, -17956,
+    -16945, -14720, -15208, -19623, -7312, -6251, 11354, -19628, -6452, -3992, -18014, -14503,
+    -11708, 2697, -9797, -13490, -11534, -2979, 2680, -8712, 769, 3449, 2506, -1289,
+    -5390, 8762, 10404, 2236, 4098, -6070, -9279, -4992, -593, 7756, 13621, 6019,
+    7888, 4440, 16574, 8747, 21312, 17883, 17005, 11950, 18310, 25973, 12377, 20240,
+    4826, 15028, 3846, 3973, -2394, 11152, 9763, 15067, 14975, 16253, 7079, 21646,
+    2772, 12821, 17129, 21127, 11396, 20049, 20082, 24952, 15344, 13363, 16779, 11784,
+    18084, 16091, 14525, 6955, 19918, 15261, 16977, 7710, 12520, 8690, 23056, 6016,
+    21621, 18173, 12485, 6012, 20791, 20226, 15398, -796, 10495, -3594, 16735, -1051,
+    19166, -3363, 9589, -1261, 18725, -6994, 12792, 5167, 11714, -2729, 16617, -7036,
+    12160, -13562, 12970, -19495, 13706, -3314, 18394, -14876, 10479, -21182, 5086, -11627,
+    -3739, -23788, -180, -15892, 3056, -14457, 5997, -15762, 8671, -9829, -3486, -6593,
+    1726, -17379, 147, -21686, -4160, -17771, -2855, -2345, -1669, -25469, -11377, -16236,
+    -4851, -13438, -10784, -21069, -18335, 4368, -13432, -5789, -23238, -8866, -8881, -472,
+    -3148, -3015, -15309, 8547, -1095, 2241, 816, -7314, -18295, -5577, -15752, -839,
+    -22689, 6340, 435, -186, -2642, 1000, 156, -78, -2387, 902, -75, 11,
+    2027, -799, 116, -63, -1621, 606, -42, -2, 1393, 551, 88, 48,
+    -1098, -409, -20, 6, 960, -372, 69, -29, -741, 283, -5, -1,
+    664, 257, 56, 23, -497, -190, 6, 4, -451, -172, -36, -12,
+    342, 133, -1, 1, 311, -119, 27, -10, -231, 89, 3, -1,
+    -210, 81, -16, 7, 160, -61, 0, 0, 145, 56, 13, 5,
+    -107, -41, 2, 1, -97, -37, -7, -3, 75, 28, 1, 0,
+    -67, 26, -6, 3, 50, -18, -1, 1, 45, -16, 3, 0,
+    -35, 14, -1, 1, 30, -11, 2, 0, -24, 10, -1, 1,
+    20, -7, 1, 0, -16, 6, 0, 0, 14, 5, 1, 0,
+    -11, 4, 0, 0, 10, 3, 1, 0, -7, 3, 0, 1,
+    6, -1, 0, 1, 5, -1, 0, 1, 4, 0, 0, 1,
+    3, 0, 0, 1, 3, 0, 1, 1, -1, 0, 1, 0,
+    -1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 13, 13, 43, 43, 106, 106, 242, 169, 536, 292,
+    1167, 560, 2524, 1135, 4658, 2368, 8918, 5013, 3439, 6903, 14490, 1749,
+    9752, -6355, 19803, -3119, 15888, -6060, 19447, -1603, 16211, -793, 3463, 2890,
+    5200, -7156, 9938, -5721, 14245, -9636, 7719, -15569, 4160, -16647, 5238, -9783,
+    6218, -14240, -1805, -24776, -9356, -6110, -2492, -13741, 3748, -11429, -304, -13531,
+    -1040, -23086, 969, -17874, -2075, -13136, -2628, -11701, -5144, -26058, -11091, -12681,
+    -3797, -14418, -10661, -19156, -6204, -490, -10256, -23383, -8046, -1838, -4698, -15828,
+    -13831, -18371, 3137, -6809, -8425, -8911, -14731, 644, -12820, 2381, -18032, 7119,
+    -13294, -60, -14729, 3855, -8203, 5041, -2270, 14749, -16293, 8223, -22026, 2290,
+    -20289, 14156, -15551, 3101, -16986, 4536, -5239, 11062, -22612, 9876, -24924, 17427,
+    -10209, 20368, -19764, 12345, -7603, 19896, -18658, 20876, -17223, 23550, -8087, 29223,
+    -18766, 18172, -14459, 799, -23595, 21611, -10543, 13217, -5331, 15760, 2565, 13448,
+    -7486, -5472, -11401, 12334, -12587, 10022, -5036, 7920, -13861, 2187, 3938, 7399,
+    -3693, -9974, -1381, -12286, -7687, -1775, 1868, 7780, -3344, -7856, 7711, 6859,
+    9146, -10341, 2620, 5846, 10926, -17278, 5533, -8045, -1331, -16439, 6692, -3721,
+    14243, -19908, 7379, -17806, 20751, -15895, 7374, -17632, 12586, -16053, 20482, -11746,
+    24789, -10441, 7821, -14000, 28633, -12922, 14643, -19786, 22274, -13546, 10712, -12736,
+    4406, -9053, 17783, -9722, 9097, -6678, 20152, -10552, 21587, -10049, 17672, -16911,
+    18858, -17891, 15622, -4519, 12681, -6430, 10007, -1218, 14059, -9114, 13323, 3808,
+    9975, 9020, 11801, 4282, 9034, 11461, 13563, 7546, 12955, 11105, 4653, 3554,
+    -1280, 6495, 14901, 9169, -1286, 16463, 5020, 5677, 10753, 27215, -1408, 17982,
+    9647, 9588, 2468, 22306, 3773, 10744, 214, 12846, -864, 22401, 116, 20664,
+    -9690, 12768, -5775, 17075, -6961, 13160, -16669, 9601, -2312, 25782, -15689, 345,
+    -20901, 17273, -13005, 14196, -2954, 11398, -6869, 13941, 8557, 2379, -18772, 21299,
+    -7600, -6682, -10985, -2958, -14062, 13970, -16860, -1419, -19403, 6975, -12466, -656,
+    -10364, -7593, -16097, -5491, -21309, -15046, -26047, -2885, -21740, 1853, -17825, -8198,
+    -23758, -12113, -9735, -13299, -11646, -20850, -23807, -12025, -22228, -20331, -9306, -17095,
+    -14518, -18075, -9780, -18966, -25574, -16535, -15063, -12852, -16974, -16200, -32610, -19244,
+    -9486, -20904, -12563, -16375, -9765, -16983, -7222, -16430, -14159, -14921, -24670, -8059,
+    -11293, -18845, -16505, 2693, -8609, -384, -10044, -8778, 6924, -11321, -13, -4384,
+    -2115, 1922, 3618, 3833, 15779, -4853, 1565, 9361, -346, 3628, 4866, 8840,
+    9604, 944, 11039, 5251,
+};
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "host_pio_program.h"
+
+HOST_PIO_PROGRAM(am_carrier)
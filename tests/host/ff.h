@@ -0,0 +1,52 @@
+// Host stand-in for FatFs: there is no card, so every mount and open fails
+#pragma once
+
+#include <stdint.h>
+
+typedef unsigned int UINT;
+typedef unsigned char BYTE;
+typedef uint32_t FSIZE_t;
+
+typedef enum { FR_OK = 0, FR_DISK_ERR, FR_NOT_READY = 3, FR_NO_FILE = 4 } FRESULT;
+
+typedef struct { int unused; } FATFS;
+typedef struct { FSIZE_t fptr, obj_size; } FIL;
+typedef struct { int unused; } DIR;
+typedef struct {
+    FSIZE_t fsize;
+    BYTE fattrib;
+    char fname[256];
+} FILINFO;
+
+#define FA_READ 0x01
+#define AM_HID 0x02
+#define AM_DIR 0x10
+
+#define f_tell(fp) ((fp)->fptr)
+#define f_size(fp) ((fp)->obj_size)
+
+static inline FRESULT f_mount(FATFS* fs, const char* path, BYTE opt) {
+    (void)fs; (void)path; (void)opt;
+    return FR_NOT_READY;
+}
+static inline FRESULT f_open(FIL* fp, const char* path, BYTE mode) {
+    (void)fp; (void)path; (void)mode;
+    return FR_NO_FILE;
+}
+static inline FRESULT f_close(FIL* fp) { (void)fp; return FR_OK; }
+static inline FRESULT f_read(FIL* fp, void* buffer, UINT count, UINT* read) {
+    (void)fp; (void)buffer; (void)count;
+    *read = 0;
+    return FR_DISK_ERR;
+}
+static inline FRESULT f_lseek(FIL* fp, FSIZE_t offset) { (void)fp; (void)offset; return FR_DISK_ERR; }
+static inline char* f_gets(char* buffer, int size, FIL* fp) {
+    (void)buffer; (void)size; (void)fp;
+    return NULL;
+}
+static inline FRESULT f_opendir(DIR* dir, const char* path) {
+    (void)dir; (void)path;
+    return FR_NO_FILE;
+}
+static inline FRESULT f_readdir(DIR* dir, FILINFO* info) { (void)dir; (void)info; return FR_DISK_ERR; }
+static inline FRESULT f_closedir(DIR* dir) { (void)dir; return FR_OK; }
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// No flash on the host: the firmware's flash paths are PICO_ON_DEVICE only
+#define FLASH_PAGE_SIZE 256
+#define FLASH_SECTOR_SIZE 4096
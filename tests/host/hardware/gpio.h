@@ -0,0 +1,7 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+static inline void gpio_init(uint pin) { (void)pin; }
+static inline void gpio_set_dir(uint pin, bool out) { (void)pin; (void)out; }
+static inline void gpio_put(uint pin, bool value) { (void)pin; (void)value; }
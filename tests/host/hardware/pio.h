@@ -0,0 +1,91 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t txf[4];
+} pio_hw_t;
+typedef pio_hw_t* PIO;
+
+static pio_hw_t host_pio0;
+#define pio0 (&host_pio0)
+
+typedef struct {
+    const uint16_t* instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv, execctrl, shiftctrl, pinctrl;
+} pio_sm_config;
+
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE, PIO_FIFO_JOIN_TX, PIO_FIFO_JOIN_RX };
+
+static inline pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = {0};
+    return c;
+}
+static inline void sm_config_set_out_pins(pio_sm_config* c, uint base, uint count) {
+    (void)c; (void)base; (void)count;
+}
+static inline void sm_config_set_set_pins(pio_sm_config* c, uint base, uint count) {
+    (void)c; (void)base; (void)count;
+}
+static inline void sm_config_set_sideset_pins(pio_sm_config* c, uint base) {
+    (void)c; (void)base;
+}
+static inline void sm_config_set_clkdiv_int_frac(pio_sm_config* c, uint16_t div_int,
+                                                 uint8_t div_frac) {
+    (void)c; (void)div_int; (void)div_frac;
+}
+static inline void sm_config_set_out_shift(pio_sm_config* c, bool shift_right, bool autopull,
+                                           uint threshold) {
+    (void)c; (void)shift_right; (void)autopull; (void)threshold;
+}
+static inline void sm_config_set_fifo_join(pio_sm_config* c, enum pio_fifo_join join) {
+    (void)c; (void)join;
+}
+
+static inline uint pio_add_program(PIO pio, const pio_program_t* program) {
+    (void)pio; (void)program;
+    return 0;
+}
+static inline void pio_remove_program(PIO pio, const pio_program_t* program, uint offset) {
+    (void)pio; (void)program; (void)offset;
+}
+static inline int pio_claim_unused_sm(PIO pio, bool required) {
+    (void)pio; (void)required;
+    return 0;
+}
+static inline void pio_sm_unclaim(PIO pio, uint sm) { (void)pio; (void)sm; }
+static inline void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+static inline int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint base, uint count,
+                                                 bool out) {
+    (void)pio; (void)sm; (void)base; (void)count; (void)out;
+    return 0;
+}
+static inline int pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config* c) {
+    (void)pio; (void)sm; (void)offset; (void)c;
+    return 0;
+}
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    (void)pio; (void)sm; (void)enabled;
+}
+static inline void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask) { (void)pio; (void)mask; }
+static inline void pio_clkdiv_restart_sm_mask(PIO pio, uint32_t mask) { (void)pio; (void)mask; }
+static inline void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t div_int,
+                                              uint8_t div_frac) {
+    (void)pio; (void)sm; (void)div_int; (void)div_frac;
+}
+static inline bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) {
+    (void)pio; (void)sm;
+    return true;
+}
+static inline void pio_sm_put(PIO pio, uint sm, uint32_t data) {
+    (void)pio; (void)sm; (void)data;
+}
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    (void)pio; (void)sm; (void)is_tx;
+    return 0;
+}
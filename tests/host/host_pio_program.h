@@ -0,0 +1,14 @@
+// Host stand-in for a pioasm header: the program object and its default
+// configuration, with one placeholder instruction. The PIO never runs on
+// the host; the firmware only compares and loads these.
+#pragma once
+
+#include "hardware/pio.h"
+
+#define HOST_PIO_PROGRAM(name)                                                  \
+    static const uint16_t name##_program_instructions[] = {0};                  \
+    static const pio_program_t name##_program = {name##_program_instructions, 1, -1}; \
+    static inline pio_sm_config name##_program_get_default_config(uint offset) { \
+        (void)offset;                                                           \
+        return pio_get_default_sm_config();                                     \
+    }
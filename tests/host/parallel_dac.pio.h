@@ -0,0 +1,7 @@
+#pragma once
+
+#include "host_pio_program.h"
+
+HOST_PIO_PROGRAM(parallel_dac_4)
+HOST_PIO_PROGRAM(parallel_dac_6)
+HOST_PIO_PROGRAM(parallel_dac_8)
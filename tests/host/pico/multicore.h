@@ -0,0 +1,7 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+// Core 1 never runs on the host
+static inline void multicore_launch_core1(void (*entry)(void)) { (void)entry; }
+static inline void multicore_reset_core1(void) {}
@@ -0,0 +1,49 @@
+// Host stand-in for the Pico SDK: just what the firmware uses, as no-ops
+// except for time, which follows the host's monotonic clock. Only
+// tests/host_tests.c is built against these headers.
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define PICO_ERROR_TIMEOUT (-1)
+#define GPIO_OUT 1
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+static inline uint64_t time_us_64(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+
+static inline void sleep_us(uint64_t us) {
+    struct timespec delay = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+    nanosleep(&delay, NULL);
+}
+static inline void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000); }
+
+static inline bool stdio_init_all(void) { return true; }
+static inline int getchar_timeout_us(uint32_t us) { (void)us; return PICO_ERROR_TIMEOUT; }
+static inline int putchar_raw(int c) { return putchar(c); }
+
+static inline void tight_loop_contents(void) {}
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
+static inline void __dmb(void) {}
+static inline uint get_core_num(void) { return 0; }
+
+static inline void set_sys_clock_pll(uint32_t vco_hz, uint postdiv1, uint postdiv2) {
+    (void)vco_hz; (void)postdiv1; (void)postdiv2;
+}
+
+#include "hardware/gpio.h"
@@ -0,0 +1,511 @@
+/**
+ * Host unit tests for the AM transmitter's pure functions
+ *
+ * Built only for the Pico SDK host platform (cmake -DPICO_PLATFORM=host)
+ * and run by ctest. The firmware source is included whole, with its main()
+ * left out, so every test calls the same code the RP2040 runs; the SDK
+ * headers it includes come from tests/host instead.
+ */
+
+#define HOST_TESTS 1
+#include "comprehensive_am_transmitter.c"
+
+#include "tests/adpcm_fixture.h"
+
+static int checks_run = 0;
+static int checks_failed = 0;
+
+#define CHECK(condition, ...) do {                                  \
+        checks_run++;                                               \
+        if (!(condition)) {                                         \
+            checks_failed++;                                        \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+            printf(__VA_ARGS__);                                    \
+            printf("\n");                                           \
+        }                                                           \
+    } while (0)
+
+// ============================================================================
+// IMA-ADPCM
+// ============================================================================
+
+// Every block of a fixture decoded and compared sample for sample with
+// ffmpeg's output; returns the number of samples compared
+static uint32_t check_adpcm_fixture(const char* name, const uint8_t* data, uint32_t size,
+                                    uint32_t block_align, uint16_t channels,
+                                    const int16_t* reference, uint32_t reference_samples) {
+    static int16_t pcm[BUFFER_SIZE * 2];
+    uint32_t compared = 0;
+    
+    for (uint32_t offset = 0; offset < size; offset += block_align) {
+        uint32_t frames = ima_adpcm_decode_block(&data[offset], block_align, channels, pcm);
+        CHECK(frames == ima_adpcm_frames_per_block(block_align, channels),
+              "%s block at %d: %d frames", name, offset, frames);
+        for (uint32_t i = 0; i < frames * channels && compared < reference_samples; i++) {
+            if (pcm[i] != reference[compared]) {
+                CHECK(false, "%s sample %d: decoded %d, reference %d", name, compared,
+                      pcm[i], reference[compared]);
+                return compared;
+            }
+            compared++;
+        }
+    }
+    CHECK(compared == reference_samples, "%s: compared %d of %d samples", name, compared,
+          reference_samples);
+    return compared;
+}
+
+static void test_ima_adpcm_bit_exact(void) {
+    check_adpcm_fixture("mono", adpcm_fixture_mono, sizeof(adpcm_fixture_mono),
+                        ADPCM_FIXTURE_MONO_BLOCK_ALIGN, ADPCM_FIXTURE_MONO_CHANNELS,
+                        adpcm_fixture_mono_pcm, count_of(adpcm_fixture_mono_pcm));
+    check_adpcm_fixture("stereo", adpcm_fixture_stereo, sizeof(adpcm_fixture_stereo),
+                        ADPCM_FIXTURE_STEREO_BLOCK_ALIGN, ADPCM_FIXTURE_STEREO_CHANNELS,
+                        adpcm_fixture_stereo_pcm, count_of(adpcm_fixture_stereo_pcm));
+    
+    // Host speed, for comparison with the device self-test's cycles/sample
+    static int16_t pcm[BUFFER_SIZE * 2];
+    const uint32_t passes = 2000;
+    uint32_t samples = 0;
+    uint64_t start = time_us_64();
+    for (uint32_t pass = 0; pass < passes; pass++) {
+        for (uint32_t offset = 0; offset < sizeof(adpcm_fixture_mono);
+             offset += ADPCM_FIXTURE_MONO_BLOCK_ALIGN) {
+            samples += ima_adpcm_decode_block(&adpcm_fixture_mono[offset],
+                                              ADPCM_FIXTURE_MONO_BLOCK_ALIGN, 1, pcm);
+        }
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    printf("IMA-ADPCM: host decode %.1f ns/sample\n",
+           elapsed_us * 1000.0f / samples);
+}
+
+// ============================================================================
+// CLOCK PLANNER
+// ============================================================================
+
+#define PLAN_STOCK_8X_MAX_ERROR_HZ 20  // README: every station within about 20 Hz
+
+// Every station, every profile and every power-of-two oversampling: a plan
+// exists, its PLL and PIO settings are ones the hardware accepts, and the
+// carrier it produces, worked out here independently, is as close as the
+// rounded 16.8 divider allows
+static void test_clock_plans_for_every_station(void) {
+    uint32_t worst_stock_8x_mhz = 0;
+    
+    for (uint32_t p = 0; p < NUM_OVERCLOCK_PROFILES; p++) {
+        const overclock_profile_t* profile = &overclock_profiles[p];
+        for (uint32_t oversampling = 1; oversampling <= 32; oversampling *= 2) {
+            for (uint32_t i = 0; i < NUM_MELBOURNE_STATIONS; i++) {
+                const am_station_t* station = &melbourne_stations[i];
+                clock_plan_t plan = {0};
+                bool found = plan_profile_clock(station->frequency, oversampling, profile, &plan);
+                CHECK(found, "%s at %dx, profile %s: no plan", station->callsign, oversampling,
+                      profile->name);
+                if (!found) continue;
+                
+                // PLL_SYS: 12 MHz x FBDIV 16-320, VCO 750-1600 MHz, post dividers 1-7
+                uint32_t fbdiv = plan.vco_hz / CLOCK_PLAN_XOSC_HZ;
+                CHECK(plan.vco_hz % CLOCK_PLAN_XOSC_HZ == 0 && fbdiv >= 16 && fbdiv <= 320,
+                      "%s: VCO %d Hz is not 12 MHz x 16-320", station->callsign, plan.vco_hz);
+                CHECK(plan.vco_hz >= CLOCK_PLAN_VCO_MIN_HZ && plan.vco_hz <= CLOCK_PLAN_VCO_MAX_HZ,
+                      "%s: VCO %d Hz out of range", station->callsign, plan.vco_hz);
+                CHECK(plan.postdiv1 >= 1 && plan.postdiv1 <= 7 && plan.postdiv2 >= 1 &&
+                      plan.postdiv2 <= plan.postdiv1,
+                      "%s: post dividers %d/%d", station->callsign, plan.postdiv1, plan.postdiv2);
+                CHECK((uint64_t)plan.sys_hz * plan.postdiv1 * plan.postdiv2 == plan.vco_hz,
+                      "%s: clk_sys %d Hz is not VCO / post dividers", station->callsign,
+                      plan.sys_hz);
+                CHECK(plan.sys_hz >= profile->min_sys_hz && plan.sys_hz <= profile->max_sys_hz,
+                      "%s: clk_sys %d Hz outside profile %s", station->callsign, plan.sys_hz,
+                      profile->name);
+                CHECK(plan.vreg_voltage == profile->vreg_voltage,
+                      "%s: core voltage not the profile's", station->callsign);
+                
+                // PIO divider 1.0 .. 65535 + 255/256
+                uint32_t div256 = plan.div_int * 256 + plan.div_frac;
+                CHECK(plan.div_int >= 1 && plan.div_int <= 0xFFFF && plan.div_frac <= 0xFF,
+                      "%s: PIO divider %d + %d/256", station->callsign, plan.div_int,
+                      plan.div_frac);
+                
+                // Carrier actually produced, and the error the plan reports
+                double carrier = plan.sys_hz * 256.0 / (div256 * 2.0 * oversampling);
+                double error_hz = fabs(carrier - station->frequency);
+                CHECK(fabs(error_hz - plan.error_mhz / 1000.0) < 0.002,
+                      "%s: plan reports %.3f Hz error, produces %.3f Hz", station->callsign,
+                      plan.error_mhz / 1000.0, error_hz);
+                double half_step_hz = station->frequency / (2.0 * div256);
+                CHECK(error_hz <= half_step_hz + 0.002,
+                      "%s at %dx, profile %s: %.3f Hz off, divider rounding allows %.3f",
+                      station->callsign, oversampling, profile->name, error_hz, half_step_hz);
+                
+                if (p == 0 && oversampling == 8 && plan.error_mhz > worst_stock_8x_mhz) {
+                    worst_stock_8x_mhz = plan.error_mhz;
+                }
+            }
+        }
+    }
+    
+    CHECK(worst_stock_8x_mhz <= PLAN_STOCK_8X_MAX_ERROR_HZ * 1000,
+          "stock profile at 8x: worst station %.3f Hz off, bound %d Hz",
+          worst_stock_8x_mhz / 1000.0, PLAN_STOCK_8X_MAX_ERROR_HZ);
+    printf("Clock plans: %d stations x %d profiles x 6 rates; worst at 8x stock %.3f Hz\n",
+           (int)NUM_MELBOURNE_STATIONS, (int)NUM_OVERCLOCK_PROFILES, worst_stock_8x_mhz / 1000.0);
+}
+
+// ============================================================================
+// MULTI-PHASE CARRIER
+// ============================================================================
+
+// Harmonic k of one pulse driven over cycles [start, end), as I/Q against
+// a carrier of `period` PIO cycles
+static void add_pulse_harmonic(double start, double end, double weight, int k, double period,
+                               double* i_sum, double* q_sum) {
+    double w = 2.0 * M_PI * k / period;
+    *i_sum += weight * (sin(w * end) - sin(w * start)) / w;
+    *q_sum += weight * (cos(w * end) - cos(w * start)) / w;
+}
+
+// The multiphase_carrier program decoded: each word lasts lead + width +
+// low + 5 cycles and drives its pin pattern for width cycles from lead + 3.
+// For each envelope level, the three phases (T/8 apart, weighted
+// 1 : sqrt 2 : 1 as by the 1.41R : R : 1.41R resistors) are summed; the
+// carrier phase must not follow the envelope beyond the +-1/4 cycle of an
+// odd remainder, and the 3rd and 5th harmonics must cancel.
+static void test_multiphase_pulses_centred(void) {
+    for (uint32_t half = 16; half <= 32; half += 4) {
+        design_multiphase_words(half);
+        double period = 2.0 * half;
+        double min_phase = 360, max_phase = -360, last_amplitude = 0;
+        double worst_harmonic_db = -300;
+        bool width_2 = false, width_3 = false;
+        
+        for (uint32_t i = 0; i <= 256; i++) {
+            double harmonic_i[6] = {0}, harmonic_q[6] = {0};
+            bool silent = false;
+            
+            for (uint32_t index = 0; index < 2; index++) {
+                uint32_t word = multiphase_word(i << 5, index);
+                uint32_t lead = word >> 22, width = ((word >> 12) & 0x3FF) + 2;
+                uint32_t pattern = (word >> 10) & 3, low = word & 0x3FF;
+                CHECK(lead + width + low + 5 == half, "half %d, level %d: word takes %d cycles",
+                      half, i, lead + width + low + 5);
+                CHECK(pattern == (index ? 2u : 1u) || pattern == 0, "level %d: pattern %d", i,
+                      pattern);
+                silent = pattern == 0;
+                if (silent) break;
+                width_2 |= width == 2;
+                width_3 |= width == 3;
+                
+                // P pulses add, N pulses subtract; phase k starts k T/8 late
+                double start = index * half + lead + 3;
+                double sign = index ? -1.0 : 1.0;
+                for (int phase = 0; phase < MULTIPHASE_PHASES; phase++) {
+                    double weight = phase == 1 ? 1.0 : M_SQRT1_2;
+                    double delay = phase * half / 4.0;
+                    for (int k = 1; k <= 5; k += 2) {
+                        add_pulse_harmonic(start + delay, start + delay + width, sign * weight, k,
+                                           period, &harmonic_i[k], &harmonic_q[k]);
+                    }
+                }
+            }
+            if (silent) continue;
+            
+            double amplitude = hypot(harmonic_i[1], harmonic_q[1]);
+            double phase_deg = atan2(harmonic_q[1], harmonic_i[1]) * 180.0 / M_PI;
+            if (phase_deg < min_phase) min_phase = phase_deg;
+            if (phase_deg > max_phase) max_phase = phase_deg;
+            CHECK(amplitude >= last_amplitude - 1e-9, "half %d: level %d weaker than %d", half,
+                  i, i - 1);
+            last_amplitude = amplitude;
+            for (int k = 3; k <= 5; k += 2) {
+                double db = 20.0 * log10(hypot(harmonic_i[k], harmonic_q[k]) / amplitude + 1e-12);
+                if (db > worst_harmonic_db) worst_harmonic_db = db;
+            }
+        }
+        
+        double allowed = 360.0 * 0.5 / period;  // Odd remainders: 1/2 cycle apart
+        CHECK(max_phase - min_phase <= allowed + 1e-6,
+              "half %d: carrier phase moves %.2f deg with the envelope, allowed %.2f", half,
+              max_phase - min_phase, allowed);
+        CHECK(worst_harmonic_db < -100, "half %d: 3rd/5th harmonic at %.1f dBc", half,
+              worst_harmonic_db);
+        CHECK(width_2 && width_3, "half %d: widths 2 and 3 not both used", half);
+        printf("Multi-phase %dx: AM-PM %.2f deg p-p, 3rd/5th %.0f dBc\n", half,
+               max_phase - min_phase, worst_harmonic_db);
+    }
+}
+
+// ============================================================================
+// C-QUAM
+// ============================================================================
+
+#define CQAM_TEST_RAMP_WORDS 64
+#define CQAM_TEST_HOLD_WORDS 512
+
+// Receiver model: the fundamental of am_carrier's pulse train, as I/Q
+// against the nominal carrier. Each word is high for high + 2 cycles from
+// cycle 3 and lasts high + low + 7. One transmission runs through it, so
+// the envelope and phase can move between measurements.
+typedef struct {
+    cqam_state_t state;
+    double t;                     // PIO cycles since the first word
+    uint16_t envelope;
+    int16_t phase;
+} cqam_receiver_t;
+
+// Ramp the envelope and phase to new values, hold them, and return the
+// carrier phase, degrees, of cos(wt + phase) over the last half of the hold
+static double cqam_receive(cqam_receiver_t* rx, uint16_t envelope, int16_t phase) {
+    double w = 2.0 * M_PI / cqam_period;
+    double i_sum = 0, q_sum = 0;
+    
+    for (int32_t n = 0; n < CQAM_TEST_RAMP_WORDS + CQAM_TEST_HOLD_WORDS; n++) {
+        int32_t k = n < CQAM_TEST_RAMP_WORDS ? n : CQAM_TEST_RAMP_WORDS;
+        int32_t e = rx->envelope + ((int32_t)envelope - rx->envelope) * k / CQAM_TEST_RAMP_WORDS;
+        int32_t p = rx->phase + ((int32_t)phase - rx->phase) * k / CQAM_TEST_RAMP_WORDS;
+        uint32_t word = cqam_word(&rx->state, (uint16_t)e, (int16_t)p);
+        uint32_t high = word >> 16, low = word & 0xFFFF;
+        if (n >= CQAM_TEST_RAMP_WORDS + CQAM_TEST_HOLD_WORDS / 2) {
+            double start = rx->t + 3, end = rx->t + 3 + high + 2;
+            i_sum += (sin(w * end) - sin(w * start)) / w;
+            q_sum += (cos(w * end) - cos(w * start)) / w;
+        }
+        rx->t += high + low + 7;
+    }
+    rx->envelope = envelope;
+    rx->phase = phase;
+    return atan2(q_sum, i_sum) * 180.0 / M_PI;
+}
+
+// Received phase of a fresh transmission at unity envelope
+static double cqam_received_phase(int16_t target) {
+    cqam_receiver_t rx = {.envelope = ENVELOPE_UNITY};
+    return cqam_receive(&rx, ENVELOPE_UNITY, target);
+}
+
+// A receiver decodes L-R from the sine of the carrier phase, so L > R has
+// to come out of the pulse train as a positive phase, and by the QUAM angle
+static void test_cqam_phase_polarity(void) {
+    config.modulation_depth = 100;
+    generate_sine_lut();
+    design_cqam(16, 44100);
+    cqam_pilot_step = 0;  // Pilot held at its zero crossing
+    
+    double reference = cqam_received_phase(0);
+    const int16_t differences[] = {16384, -16384, 8192, -8192};
+    for (uint32_t k = 0; k < count_of(differences); k++) {
+        // (L-R)/2 at 100% depth against an L+R envelope of unity
+        double expected = atan2(differences[k] / 32768.0, 1.0) * 180.0 / M_PI;
+        int16_t phase = cqam_phase(ENVELOPE_UNITY, differences[k]);
+        double computed = phase * 360.0 / 65536.0;
+        CHECK(fabs(computed - expected) < 0.1, "cqam_phase(L-R %d) = %.2f deg, QUAM angle %.2f",
+              differences[k], computed, expected);
+        
+        double received = cqam_received_phase(phase) - reference;
+        CHECK(fabs(received - computed) < 0.1,
+              "L-R %d: carrier sent %.2f deg, receiver sees %.2f deg", differences[k],
+              computed, received);
+    }
+}
+
+// The pulse width follows the envelope but its centre must not: a moving
+// centre is phase, which a C-QUAM decoder reads as L-R. One transmission
+// at a fixed phase sweeps the envelope from 5% to 190% of unity (the
+// limits compute_envelope() allows) and back.
+static void test_cqam_phase_independent_of_envelope(void) {
+    const int16_t phases[] = {0, 5461};  // L-R = 0, and +30 degrees
+    
+    for (uint32_t oversampling = 8; oversampling <= 32; oversampling *= 2) {
+        design_cqam(oversampling, 44100);
+        double worst = 0;
+        for (uint32_t k = 0; k < count_of(phases); k++) {
+            cqam_receiver_t rx = {.envelope = ENVELOPE_UNITY};
+            double reference = cqam_receive(&rx, ENVELOPE_UNITY, phases[k]);
+            for (int pass = 0; pass < 2; pass++) {
+                for (int step = 0; step < 38; step++) {
+                    int pct = pass == 0 ? 190 - 5 * step : 5 + 5 * step;
+                    uint16_t envelope = (uint16_t)(ENVELOPE_UNITY * pct / 100);
+                    double moved = cqam_receive(&rx, envelope, phases[k]) - reference;
+                    if (moved > 180) moved -= 360;
+                    if (moved < -180) moved += 360;
+                    CHECK(fabs(moved) < 0.25,
+                          "%dx, phase %d: at %d%% envelope the carrier moves %.2f deg",
+                          oversampling, phases[k], pct, moved);
+                    if (fabs(moved) > worst) worst = fabs(moved);
+                }
+            }
+        }
+        printf("C-QUAM %dx: carrier phase within %.3f deg over 5-190%% envelope\n", oversampling,
+               worst);
+    }
+    design_cqam(16, 44100);
+}
+
+// dpd_fit.py multiplies the carrier by exp(+j 2 pi phase) for a table
+// phase, so the receiver has to see the QUAM angle plus the table's phase
+static void test_dpd_phase_correction_sign(void) {
+    static pipeline_block_t block;
+    config.signal_mode = SIGNAL_MODE_CQAM;
+    config.enable_predistortion = true;
+    active_predistortion = PREDISTORT_LUT;
+    
+    double reference = cqam_received_phase(0);
+    const int16_t corrections[] = {1820, -1820};  // +-10 degrees
+    for (uint32_t k = 0; k < count_of(corrections); k++) {
+        for (int p = 0; p < DPD_LUT_POINTS; p++) {
+            dpd_table.gain[p] = ENVELOPE_UNITY;
+            dpd_table.phase[p] = corrections[k];
+        }
+        audio_rate_sample(&block, 0, 0, 8192);
+        
+        double expected = (atan2(8192 / 32768.0, 1.0) + 2.0 * M_PI * corrections[k] / 65536.0) *
+                          180.0 / M_PI;
+        double received = cqam_received_phase(block.phase[0]) - reference;
+        CHECK(fabs(received - expected) < 0.1,
+              "table phase %d: receiver sees %.2f deg, dpd_fit.py expects %.2f deg",
+              corrections[k], received, expected);
+    }
+    
+    design_dpd_default();
+    config.enable_predistortion = false;
+}
+
+// ============================================================================
+// Timing-word requantiser
+// ============================================================================
+
+// Coherent run: the carrier and the tone fall on whole DFT bins of
+// REQUANT_TEST_WORDS, and the carrier on whole waveform_lut steps
+#define REQUANT_TEST_WORDS 65536
+#define REQUANT_TEST_CARRIER 9808    // Bins: the NCO at 0.15 cycles per word
+#define REQUANT_TEST_TONE 96         // 1 kHz at 16x 44.1 kHz
+#define REQUANT_TEST_BAND 928        // +-10 kHz around the carrier
+
+typedef struct {
+    double snr_db;                // Carrier and sidebands to requantisation error, in band
+    double sfdr_db;               // Carrier to the largest in-band error bin
+    uint32_t clamped;             // Words whose error hit the +-2 lsb clamp
+} requantiser_result_t;
+
+// The SIMPLE mode's RF path, generate_am_signal() at full modulation depth
+// into the timing word, with the word's high time compared with the level
+// each requantiser aims for
+static requantiser_result_t requantise_tone(bool shaped) {
+    static float amplitude[REQUANT_TEST_WORDS], error[REQUANT_TEST_WORDS];
+    static double cosine[REQUANT_TEST_WORDS], sine[REQUANT_TEST_WORDS];
+    const int32_t lsb = 4096 / PIO_TIMING_LEVELS;
+    requantiser_result_t result = {0};
+    
+    phase_increment = REQUANT_TEST_CARRIER * (UINT32_MAX / REQUANT_TEST_WORDS + 1);
+    phase_accumulator = 0;
+    requantiser_state_t state = {.feedback = requantiser_feedback(phase_increment), .dither = 1};
+    for (uint32_t n = 0; n < REQUANT_TEST_WORDS; n++) {
+        double angle = 2.0 * M_PI * n / REQUANT_TEST_WORDS;
+        cosine[n] = cos(angle);
+        sine[n] = sin(angle);
+        
+        int16_t audio = (int16_t)lround(32767 * sin(angle * REQUANT_TEST_TONE));
+        uint32_t wanted = generate_am_signal(compute_envelope(audio));
+        uint32_t word = shaped ? shaped_pio_timing(&state, wanted) : convert_to_pio_timing(wanted);
+        int32_t target = shaped ? shaped_pio_target(wanted) : (int32_t)wanted;
+        amplitude[n] = (float)target;
+        error[n] = (float)((int32_t)(word >> 16) * lsb - target);
+        if (shaped && (state.error[0] >= 2 * lsb || state.error[0] <= -2 * lsb)) {
+            result.clamped++;
+        }
+    }
+    
+    double signal = 0, noise = 0, largest = 0, carrier = 0;
+    for (uint32_t k = REQUANT_TEST_CARRIER - REQUANT_TEST_BAND;
+         k <= REQUANT_TEST_CARRIER + REQUANT_TEST_BAND; k++) {
+        double si = 0, sq = 0, ei = 0, eq = 0;
+        uint32_t index = 0;
+        for (uint32_t n = 0; n < REQUANT_TEST_WORDS; n++) {
+            si += amplitude[n] * cosine[index];
+            sq += amplitude[n] * sine[index];
+            ei += error[n] * cosine[index];
+            eq += error[n] * sine[index];
+            index = (index + k) % REQUANT_TEST_WORDS;
+        }
+        double s = si * si + sq * sq, e = ei * ei + eq * eq;
+        signal += s;
+        noise += e;
+        if (e > largest) largest = e;
+        if (k == REQUANT_TEST_CARRIER) carrier = s;
+    }
+    result.snr_db = 10.0 * log10(signal / noise);
+    result.sfdr_db = 10.0 * log10(carrier / largest);
+    return result;
+}
+
+// Shaping has to buy at least 20 dB of in-band SNR and 30 dB of SFDR over
+// truncation, and a full-depth signal must never reach the error clamp,
+// which is only there to keep an overloaded loop from winding up
+static void test_requantiser_shapes_noise_out_of_band(void) {
+    config.signal_mode = SIGNAL_MODE_SIMPLE;
+    config.modulation_depth = 100;
+    generate_sine_lut();
+    
+    requantiser_result_t plain = requantise_tone(false);
+    requantiser_result_t shaped = requantise_tone(true);
+    printf("Requantiser: in-band SNR %.1f dB shaped, %.1f dB truncated; "
+           "SFDR %.1f dB, %.1f dB; %d clamped word(s)\n", shaped.snr_db, plain.snr_db,
+           shaped.sfdr_db, plain.sfdr_db, shaped.clamped);
+    CHECK(shaped.snr_db >= plain.snr_db + 20, "in-band SNR %.1f dB shaped, %.1f dB truncated",
+          shaped.snr_db, plain.snr_db);
+    CHECK(shaped.sfdr_db >= plain.sfdr_db + 30, "SFDR %.1f dB shaped, %.1f dB truncated",
+          shaped.sfdr_db, plain.sfdr_db);
+    CHECK(shaped.clamped == 0, "%d word(s) at the +-2 lsb error clamp at full depth",
+          shaped.clamped);
+}
+
+// ============================================================================
+// Fine PWM
+// ============================================================================
+
+// Every oversampling rate finepwm accepts, through the startup self-test's
+// model of fine_pwm.pio: noise-shaped widths have to reach 10 effective
+// bits below carrier / 64, beating rounding, and no word may miss the
+// carrier period
+static void test_fine_pwm_resolution(void) {
+    float worst = 99;
+    uint32_t worst_rate = 0;
+    
+    generate_sine_lut();
+    for (uint32_t oversampling = FINE_PWM_MIN_OVERSAMPLING; oversampling <= 32; oversampling++) {
+        design_fine_pwm(oversampling);
+        uint32_t shaped_errors, plain_errors;
+        float shaped = fine_pwm_effective_bits(true, &shaped_errors);
+        float plain = fine_pwm_effective_bits(false, &plain_errors);
+        CHECK(shaped >= 10.0f && shaped > plain,
+              "%dx: %.1f effective bits noise-shaped, %.1f rounded", oversampling, shaped, plain);
+        CHECK(shaped_errors == 0 && plain_errors == 0,
+              "%dx: %d shaped and %d rounded word(s) missed the carrier period", oversampling,
+              shaped_errors, plain_errors);
+        if (shaped < worst) {
+            worst = shaped;
+            worst_rate = oversampling;
+        }
+    }
+    printf("Fine PWM %d-32x: at least %.1f effective bits noise-shaped (%dx)\n",
+           FINE_PWM_MIN_OVERSAMPLING, worst, worst_rate);
+}
+
+// ============================================================================
+
+int main(void) {
+    (void)parse_command_line;  // Only the firmware's main() parses arguments
+    
+    test_ima_adpcm_bit_exact();
+    test_clock_plans_for_every_station();
+    test_multiphase_pulses_centred();
+    test_cqam_phase_polarity();
+    test_cqam_phase_independent_of_envelope();
+    test_dpd_phase_correction_sign();
+    test_requantiser_shapes_noise_out_of_band();
+    test_fine_pwm_resolution();
+    
+    printf("%d checks, %d failed\n", checks_run, checks_failed);
+    return checks_failed ? 1 : 0;
+}